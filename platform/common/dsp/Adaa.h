@@ -0,0 +1,554 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    Adaa.h
+ * @brief   Antiderivative antialiased (ADAA) waveshapers.
+ *
+ * Cheaper than oversampling for static nonlinearities: the output is the
+ * average of the curve over the segment between consecutive input samples,
+ * computed from its antiderivative. First order needs F1, second order F2.
+ *
+ *   y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])                      (first order)
+ *   y[n] = 2 / (x[n] - x[n-2]) * (D(x[n], x[n-1]) - D(x[n-1], x[n-2]))
+ *   D(a, b) = (F2(a) - F2(b)) / (a - b)                                    (second order)
+ *
+ * Segments shorter than kEpsilon fall back to evaluating the curve at the
+ * midpoint, as described in J. Chowdhury, "Practical considerations for
+ * antiderivative anti-aliasing", 2020. First order adds half a sample of
+ * delay, second order one sample. Both roll off the top octave slightly.
+ *
+ * Curves, each providing F0 (the curve), F1, F2 and float32x4_t versions:
+ *   SoftClip     osc_softclipf()
+ *   SatCubic     osc_sat_cubicf()
+ *   SatSchetzen  osc_sat_schetzenf()
+ *   Tanh         tanh, the odd extension of fastertanhf() which only holds for x >= 0
+ *   Overdrive    the pluck overdrive, fast_tanh() of the driven input mixed with the dry input,
+ *                tabulated like the others
+ *
+ * SatCubic and SatSchetzen follow cubicsat_lut_f and schetzen_lut_f over the
+ * whole table. Note that osc_sat_cubicf() and osc_sat_schetzenf() index the
+ * table with the unscaled input and only ever read its first segment.
+ *
+ * Like Oversampler, state is kept per lane and x1/x4 methods take the index of
+ * the first lane they work on.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/int_math.h"
+#include "utils/float_simd.h"
+#include "utils/float_simd_approx.h"
+#include "dsp/AdaaTables.h"
+
+namespace dsp
+{
+namespace adaa
+{
+
+/*===========================================================================*/
+/* Curves. */
+/*===========================================================================*/
+
+// x - c * x^3 on the input clipped to [-1, 1], as osc_softclipf(c, x)
+class SoftClip
+{
+public:
+    explicit SoftClip(float c = 1.f / 3.f):
+    mC(c)
+    {
+    }
+
+    fast_inline float F0(float x) const
+    {
+        x = clip1m1f(x);
+        return x - mC * x * x * x;
+    }
+
+    // Polynomial up to |x| = 1, then the constant 1 - c continues linearly
+    fast_inline float F1(float x) const
+    {
+        const float a = si_fabsf(x);
+        const float b = clipmaxf(a, 1.f);
+        const float d = a - b;
+        const float bb = b * b;
+        return bb * (0.5f - 0.25f * mC * bb) + (1.f - mC) * d;
+    }
+
+    fast_inline float F2(float x) const
+    {
+        const float a = si_fabsf(x);
+        const float b = clipmaxf(a, 1.f);
+        const float d = a - b;
+        const float bb = b * b;
+        const float f2 = bb * b * (1.f / 6.f - 0.05f * mC * bb) + (0.5f - 0.25f * mC) * d + 0.5f * (1.f - mC) * d * d;
+        return si_copysignf(f2, x);
+    }
+
+    fast_inline float32x4_t F0X4(float32x4_t x) const
+    {
+        x = clip1m1fx4(x);
+        return float32x4_fmulscalsub(x, float32x4_mul(x, float32x4_mul(x, x)), mC);
+    }
+
+    fast_inline float32x4_t F1X4(float32x4_t x) const
+    {
+        const float32x4_t a = si_fabsfx4(x);
+        const float32x4_t b = clipmaxfx4(a, f32x4_dup(1.f));
+        const float32x4_t d = float32x4_sub(a, b);
+        const float32x4_t bb = float32x4_mul(b, b);
+        const float32x4_t poly = float32x4_mul(bb, float32x4_fmulscalsub(f32x4_dup(0.5f), bb, 0.25f * mC));
+        return float32x4_fmulscaladd(poly, d, 1.f - mC);
+    }
+
+    fast_inline float32x4_t F2X4(float32x4_t x) const
+    {
+        const float32x4_t a = si_fabsfx4(x);
+        const float32x4_t b = clipmaxfx4(a, f32x4_dup(1.f));
+        const float32x4_t d = float32x4_sub(a, b);
+        const float32x4_t bb = float32x4_mul(b, b);
+        float32x4_t f2 = float32x4_mul(float32x4_mul(bb, b), float32x4_fmulscalsub(f32x4_dup(1.f / 6.f), bb, 0.05f * mC));
+        f2 = float32x4_fmulscaladd(f2, d, 0.5f - 0.25f * mC);
+        f2 = float32x4_fmulscaladd(f2, float32x4_mul(d, d), 0.5f * (1.f - mC));
+        return si_copysignfx4(f2, x);
+    }
+
+private:
+    float mC;
+};
+
+// Odd curve given as a linearly interpolated table over [0, range], constant beyond.
+// F1 and F2 are exact for the interpolated table.
+class TableCurve
+{
+public:
+    enum {
+        kSize = 128   // segments, tables hold kSize + 1 points
+    };
+
+    TableCurve(const float * f0, const float * f1, const float * f2, float range):
+    mF0(f0),
+    mF1(f1),
+    mF2(f2),
+    mRange(range),
+    mStep(range / kSize),
+    mStepRecip(kSize / range)
+    {
+    }
+
+    fast_inline float F0(float x) const
+    {
+        float s;
+        const uint32_t i = Index(si_fabsf(x), s);
+        return si_copysignf(linintf(s, mF0[i], mF0[i + 1]), x);
+    }
+
+    fast_inline float F1(float x) const
+    {
+        const float a = si_fabsf(x);
+        float s;
+        const uint32_t i = Index(a, s);
+        const float ds = s * mStep;
+        const float y0 = mF0[i];
+        const float dy = mF0[i + 1] - y0;
+        const float d = a - clipmaxf(a, mRange);
+        return mF1[i] + ds * (y0 + 0.5f * dy * s) + mF0[kSize] * d;
+    }
+
+    fast_inline float F2(float x) const
+    {
+        const float a = si_fabsf(x);
+        float s;
+        const uint32_t i = Index(a, s);
+        const float ds = s * mStep;
+        const float y0 = mF0[i];
+        const float dy = mF0[i + 1] - y0;
+        const float d = a - clipmaxf(a, mRange);
+        const float f1 = mF1[i] + ds * (y0 + 0.5f * dy * s);
+        float f2 = mF2[i] + ds * (mF1[i] + ds * (0.5f * y0 + (1.f / 6.f) * dy * s));
+        f2 += d * (f1 + 0.5f * mF0[kSize] * d);
+        return si_copysignf(f2, x);
+    }
+
+    // table lookups have no vector form, lanes are gathered one by one
+    fast_inline float32x4_t F0X4(float32x4_t x) const
+    {
+        return float32x4(F0(f32x4_lane(x, 0)), F0(f32x4_lane(x, 1)), F0(f32x4_lane(x, 2)), F0(f32x4_lane(x, 3)));
+    }
+
+    fast_inline float32x4_t F1X4(float32x4_t x) const
+    {
+        return float32x4(F1(f32x4_lane(x, 0)), F1(f32x4_lane(x, 1)), F1(f32x4_lane(x, 2)), F1(f32x4_lane(x, 3)));
+    }
+
+    fast_inline float32x4_t F2X4(float32x4_t x) const
+    {
+        return float32x4(F2(f32x4_lane(x, 0)), F2(f32x4_lane(x, 1)), F2(f32x4_lane(x, 2)), F2(f32x4_lane(x, 3)));
+    }
+
+private:
+    // segment index and position in it, the last segment is extended past range
+    fast_inline uint32_t Index(float a, float & s) const
+    {
+        const float idx = clipmaxf(a, mRange) * mStepRecip;
+        const uint32_t i = clipmaxu32(static_cast<uint32_t>(idx), kSize - 1);
+        s = idx - i;
+        return i;
+    }
+
+    const float * mF0;
+    const float * mF1;
+    const float * mF2;
+    float mRange;
+    float mStep;
+    float mStepRecip;
+};
+
+// osc_sat_cubicf()
+class SatCubic : public TableCurve
+{
+public:
+    SatCubic():
+    TableCurve(kCubicSatF0, kCubicSatF1, kCubicSatF2, 1.f)
+    {
+    }
+};
+
+// osc_sat_schetzenf()
+class SatSchetzen : public TableCurve
+{
+public:
+    SatSchetzen():
+    TableCurve(kSchetzenF0, kSchetzenF1, kSchetzenF2, 1.f)
+    {
+    }
+};
+
+// tanh, table over [0, 4]
+class Tanh : public TableCurve
+{
+public:
+    Tanh():
+    TableCurve(kTanhF0, kTanhF1, kTanhF2, 4.f)
+    {
+    }
+};
+
+// lerp(x, fast_tanh(x * g), m) with g = 24 * drive^3, m = drive * (2 - drive),
+// fast_tanh(u) = u / 9 + (8 / 3) * u / (u^2 + 3). The linear part is folded into
+// a single slope, the rational part is read from the kFastTanhRest* tables so that
+// F1 and F2 need no log or atan. Past u = 24 the rational part is held at its last
+// value, within 1% of the curve.
+class Overdrive
+{
+public:
+    explicit Overdrive(float drive = 0.f):
+    mRest(kFastTanhRestF0, kFastTanhRestF1, kFastTanhRestF2, 24.f)
+    {
+        SetDrive(drive);
+    }
+
+    void SetDrive(float drive)
+    {
+        const float d = clipminmaxf(0.f, drive, 1.f);
+        mGain = d * d * d * 24.f;
+        mMix = d * (2.f - d);
+        // below this the shaped path is linear to float precision
+        mMix = (mGain < 1e-3f) ? 0.f : mMix;
+        mGainRecip = (mGain > 0.f) ? 1.f / mGain : 0.f;
+        mSlope = (1.f - mMix) + mMix * mGain * (1.f / 9.f);
+        mRest1 = mMix * mGainRecip;
+        mRest2 = mRest1 * mGainRecip;
+    }
+
+    fast_inline float F0(float x) const
+    {
+        return mSlope * x + mMix * mRest.F0(x * mGain);
+    }
+
+    fast_inline float F1(float x) const
+    {
+        return 0.5f * mSlope * x * x + mRest1 * mRest.F1(x * mGain);
+    }
+
+    fast_inline float F2(float x) const
+    {
+        return (1.f / 6.f) * mSlope * x * x * x + mRest2 * mRest.F2(x * mGain);
+    }
+
+    fast_inline float32x4_t F0X4(float32x4_t x) const
+    {
+        const float32x4_t rest = mRest.F0X4(float32x4_mulscal(x, mGain));
+        return float32x4_fmulscaladd(float32x4_mulscal(x, mSlope), rest, mMix);
+    }
+
+    fast_inline float32x4_t F1X4(float32x4_t x) const
+    {
+        const float32x4_t rest = mRest.F1X4(float32x4_mulscal(x, mGain));
+        return float32x4_fmulscaladd(float32x4_mulscal(float32x4_mul(x, x), 0.5f * mSlope), rest, mRest1);
+    }
+
+    fast_inline float32x4_t F2X4(float32x4_t x) const
+    {
+        const float32x4_t rest = mRest.F2X4(float32x4_mulscal(x, mGain));
+        const float32x4_t xxx = float32x4_mul(x, float32x4_mul(x, x));
+        return float32x4_fmulscaladd(float32x4_mulscal(xxx, (1.f / 6.f) * mSlope), rest, mRest2);
+    }
+
+private:
+    TableCurve mRest;
+    float mGain;
+    float mGainRecip;
+    float mMix;
+    float mSlope;   // of the linear part, dry mix plus u / 9
+    float mRest1;   // rational part scale in F1
+    float mRest2;   // rational part scale in F2
+};
+
+}
+
+/*===========================================================================*/
+/* Shapers. */
+/*===========================================================================*/
+
+// First order ADAA, half a sample of delay
+template <typename Curve, int NumLanes = 4>
+class Adaa1
+{
+public:
+    static_assert(NumLanes % 4 == 0, "NumLanes must be a multiple of 4");
+
+    // float32 rounding of F1 dominates below this
+    static constexpr float kEpsilon = 1e-3f;
+
+    explicit Adaa1(const Curve & curve = Curve()):
+    mCurve(curve)
+    {
+        Reset();
+    }
+
+    const Curve & GetCurve() const
+    {
+        return mCurve;
+    }
+
+    // The stored antiderivatives are refreshed so that a parameter change does not click
+    void SetCurve(const Curve & curve)
+    {
+        mCurve = curve;
+        for (int l = 0; l < NumLanes; l++)
+            mF1[l] = mCurve.F1(mX1[l]);
+    }
+
+    void Reset()
+    {
+        for (int l = 0; l < NumLanes; l++)
+        {
+            mX1[l] = 0.f;
+            mF1[l] = mCurve.F1(0.f);
+        }
+    }
+
+    fast_inline float ProcessX1(const float x, int lane = 0)
+    {
+        const float x1 = mX1[lane];
+        const float f1 = mCurve.F1(x);
+        const float dx = x - x1;
+        const float y = (si_fabsf(dx) < kEpsilon) ? mCurve.F0(0.5f * (x + x1)) : (f1 - mF1[lane]) / dx;
+        mX1[lane] = x;
+        mF1[lane] = f1;
+        return y;
+    }
+
+    fast_inline float32x4_t ProcessX4(const float32x4_t x, int lane = 0)
+    {
+        const float32x4_t x1 = f32x4_ld(&mX1[lane]);
+        const float32x4_t f1 = mCurve.F1X4(x);
+        const float32x4_t dx = float32x4_sub(x, x1);
+        const uint32x4_t ill = float32x4_lt(si_fabsfx4(dx), f32x4_dup(kEpsilon));
+        // keeps the unused quotient finite
+        const float32x4_t den = float32x4_sel(ill, f32x4_dup(1.f), dx);
+        const float32x4_t y = float32x4_div_nr(float32x4_sub(f1, f32x4_ld(&mF1[lane])), den);
+        const float32x4_t mid = mCurve.F0X4(float32x4_mulscal(float32x4_add(x, x1), 0.5f));
+        f32x4_str(&mX1[lane], x);
+        f32x4_str(&mF1[lane], f1);
+        return float32x4_sel(ill, mid, y);
+    }
+
+private:
+    Curve mCurve;
+    float mX1[NumLanes];
+    float mF1[NumLanes];
+};
+
+// Second order ADAA, one sample of delay
+template <typename Curve, int NumLanes = 4>
+class Adaa2
+{
+public:
+    static_assert(NumLanes % 4 == 0, "NumLanes must be a multiple of 4");
+
+    // float32 rounding of F2 dominates below this
+    static constexpr float kEpsilon = 1e-2f;
+
+    explicit Adaa2(const Curve & curve = Curve()):
+    mCurve(curve)
+    {
+        Reset();
+    }
+
+    const Curve & GetCurve() const
+    {
+        return mCurve;
+    }
+
+    // The stored antiderivatives are refreshed so that a parameter change does not click
+    void SetCurve(const Curve & curve)
+    {
+        mCurve = curve;
+        for (int l = 0; l < NumLanes; l++)
+        {
+            mF2[l] = mCurve.F2(mX1[l]);
+            mD[l] = D(mX1[l], mX2[l], mF2[l], mCurve.F2(mX2[l]));
+        }
+    }
+
+    void Reset()
+    {
+        for (int l = 0; l < NumLanes; l++)
+        {
+            mX1[l] = mX2[l] = 0.f;
+            mF2[l] = mCurve.F2(0.f);
+            mD[l] = mCurve.F1(0.f);
+        }
+    }
+
+    fast_inline float ProcessX1(const float x, int lane = 0)
+    {
+        const float x1 = mX1[lane];
+        const float x2 = mX2[lane];
+        const float f2 = mCurve.F2(x);
+        const float d = D(x, x1, f2, mF2[lane]);
+        const float dx = x - x2;
+
+        float y;
+        if (si_fabsf(dx) >= kEpsilon)
+        {
+            y = 2.f * (d - mD[lane]) / dx;
+        }
+        else
+        {
+            const float xbar = 0.5f * (x + x2);
+            const float delta = xbar - x1;
+            y = (si_fabsf(delta) < kEpsilon)
+                ? mCurve.F0(0.5f * (xbar + x1))
+                : 2.f / delta * (mCurve.F1(xbar) + (mF2[lane] - mCurve.F2(xbar)) / delta);
+        }
+
+        mX2[lane] = x1;
+        mX1[lane] = x;
+        mF2[lane] = f2;
+        mD[lane] = d;
+        return y;
+    }
+
+    fast_inline float32x4_t ProcessX4(const float32x4_t x, int lane = 0)
+    {
+        const float32x4_t one = f32x4_dup(1.f);
+        const float32x4_t eps = f32x4_dup(kEpsilon);
+        const float32x4_t x1 = f32x4_ld(&mX1[lane]);
+        const float32x4_t x2 = f32x4_ld(&mX2[lane]);
+        const float32x4_t f2x1 = f32x4_ld(&mF2[lane]);
+        const float32x4_t f2 = mCurve.F2X4(x);
+
+        // D(x, x1)
+        const float32x4_t dx01 = float32x4_sub(x, x1);
+        const uint32x4_t ill01 = float32x4_lt(si_fabsfx4(dx01), eps);
+        float32x4_t d = float32x4_div_nr(float32x4_sub(f2, f2x1), float32x4_sel(ill01, one, dx01));
+        d = float32x4_sel(ill01, mCurve.F1X4(float32x4_mulscal(float32x4_add(x, x1), 0.5f)), d);
+
+        const float32x4_t dx02 = float32x4_sub(x, x2);
+        const uint32x4_t ill02 = float32x4_lt(si_fabsfx4(dx02), eps);
+        float32x4_t y = float32x4_div_nr(float32x4_mulscal(float32x4_sub(d, f32x4_ld(&mD[lane])), 2.f), float32x4_sel(ill02, one, dx02));
+
+        // x close to x2, only evaluated when a lane needs it
+        if (uint32x4_any(ill02))
+        {
+            const float32x4_t xbar = float32x4_mulscal(float32x4_add(x, x2), 0.5f);
+            const float32x4_t delta = float32x4_sub(xbar, x1);
+            const uint32x4_t illDelta = float32x4_lt(si_fabsfx4(delta), eps);
+            const float32x4_t deltaSafe = float32x4_sel(illDelta, one, delta);
+            const float32x4_t q = float32x4_div_nr(float32x4_sub(f2x1, mCurve.F2X4(xbar)), deltaSafe);
+            float32x4_t yb = float32x4_div_nr(float32x4_mulscal(float32x4_add(mCurve.F1X4(xbar), q), 2.f), deltaSafe);
+            yb = float32x4_sel(illDelta, mCurve.F0X4(float32x4_mulscal(float32x4_add(xbar, x1), 0.5f)), yb);
+            y = float32x4_sel(ill02, yb, y);
+        }
+
+        f32x4_str(&mX2[lane], x1);
+        f32x4_str(&mX1[lane], x);
+        f32x4_str(&mF2[lane], f2);
+        f32x4_str(&mD[lane], d);
+        return y;
+    }
+
+private:
+    // first divided difference of F2, F1 at the midpoint when a and b are too close
+    fast_inline float D(float a, float b, float f2a, float f2b) const
+    {
+        const float dx = a - b;
+        return (si_fabsf(dx) < kEpsilon) ? mCurve.F1(0.5f * (a + b)) : (f2a - f2b) / dx;
+    }
+
+    Curve mCurve;
+    float mX1[NumLanes];
+    float mX2[NumLanes];
+    float mF2[NumLanes];
+    float mD[NumLanes];
+};
+
+template <typename Curve, int NumLanes>
+constexpr float Adaa1<Curve, NumLanes>::kEpsilon;
+template <typename Curve, int NumLanes>
+constexpr float Adaa2<Curve, NumLanes>::kEpsilon;
+
+}
+/** @} */
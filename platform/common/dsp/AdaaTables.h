@@ -0,0 +1,497 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    AdaaTables.h
+ * @brief   Antiderivative tables for the ADAA shapes in Adaa.h.
+ *
+ * For each curve, F0 is the curve itself and F1, F2 its first and second
+ * antiderivatives, sampled at the same points for x >= 0 and zero at x = 0.
+ * The curves are odd, so F1 is even and F2 odd.
+ *
+ * kCubicSat* and kSchetzen* follow cubicsat_lut_f and schetzen_lut_f, 129 points
+ * over [0, 1]. F1 and F2 are exact for the linearly interpolated tables.
+ * kTanh* sample tanh(x), 129 points over [0, 4], F1 and F2 are those of the
+ * linearly interpolated table as well.
+ * kFastTanhRest* sample the rational part of fast_tanh(u) = u / 9 + (8 / 3) * u / (u^2 + 3),
+ * 129 points over [0, 24], the range of the pluck overdrive at full drive, again
+ * with F1 and F2 of the interpolated table.
+ *
+ * Generated offline, do not edit by hand.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+namespace dsp
+{
+namespace adaa
+{
+
+static const float kCubicSatF0[129] = {
+    0.f, 0.00975f, 0.019501f, 0.029251f,
+    0.039002f, 0.048752f, 0.058503f, 0.068253f,
+    0.078004f, 0.087754f, 0.097505f, 0.107255f,
+    0.117006f, 0.126756f, 0.136507f, 0.146257f,
+    0.156008f, 0.165758f, 0.175509f, 0.185259f,
+    0.19501f, 0.20476f, 0.214511f, 0.224261f,
+    0.234012f, 0.243762f, 0.253513f, 0.263263f,
+    0.273014f, 0.282764f, 0.292515f, 0.302265f,
+    0.312016f, 0.321766f, 0.331517f, 0.341267f,
+    0.351018f, 0.360768f, 0.370519f, 0.380269f,
+    0.39002f, 0.39977f, 0.409521f, 0.419271f,
+    0.429022f, 0.438772f, 0.448523f, 0.458273f,
+    0.468024f, 0.477774f, 0.487525f, 0.497275f,
+    0.507026f, 0.516776f, 0.526527f, 0.536276f,
+    0.54602f, 0.555756f, 0.56548f, 0.575188f,
+    0.584877f, 0.594543f, 0.604182f, 0.613791f,
+    0.623367f, 0.632904f, 0.642401f, 0.651853f,
+    0.661257f, 0.670609f, 0.679905f, 0.689142f,
+    0.698316f, 0.707424f, 0.716462f, 0.725426f,
+    0.734312f, 0.743118f, 0.751839f, 0.760472f,
+    0.769013f, 0.777458f, 0.785805f, 0.794048f,
+    0.802185f, 0.810213f, 0.818126f, 0.825923f,
+    0.833598f, 0.841149f, 0.848572f, 0.855863f,
+    0.863019f, 0.870036f, 0.87691f, 0.883638f,
+    0.890216f, 0.89664f, 0.902908f, 0.909014f,
+    0.914957f, 0.920731f, 0.926333f, 0.93176f,
+    0.937009f, 0.942075f, 0.946954f, 0.951644f,
+    0.95614f, 0.96044f, 0.964538f, 0.968433f,
+    0.972119f, 0.975594f, 0.978854f, 0.981895f,
+    0.984714f, 0.987306f, 0.989669f, 0.991798f,
+    0.993691f, 0.995343f, 0.99675f, 0.99791f,
+    0.998819f, 0.999472f, 0.999867f, 0.999999f,
+    0.999999f
+};
+
+static const float kCubicSatF1[129] = {
+    0.f, 3.80859375e-05f, 0.000152347656f, 0.000342785156f,
+    0.000609398438f, 0.0009521875f, 0.00137115234f, 0.00186629297f,
+    0.00243760937f, 0.00308510156f, 0.00380876953f, 0.00460861328f,
+    0.00548463281f, 0.00643682813f, 0.00746519922f, 0.00856974609f,
+    0.00975046875f, 0.0110073672f, 0.0123404414f, 0.0137496914f,
+    0.0152351172f, 0.0167967188f, 0.0184344961f, 0.0201484492f,
+    0.0219385781f, 0.0238048828f, 0.0257473633f, 0.0277660195f,
+    0.0298608516f, 0.0320318594f, 0.034279043f, 0.0366024023f,
+    0.0390019375f, 0.0414776484f, 0.0440295352f, 0.0466575977f,
+    0.0493618359f, 0.05214225f, 0.0549988398f, 0.0579316055f,
+    0.0609405469f, 0.0640256641f, 0.067186957f, 0.0704244258f,
+    0.0737380703f, 0.0771278906f, 0.0805938867f, 0.0841360586f,
+    0.0877544062f, 0.0914489297f, 0.0952196289f, 0.0990665039f,
+    0.102989555f, 0.106988781f, 0.111064184f, 0.115215758f,
+    0.119443477f, 0.123747289f, 0.128127117f, 0.132582852f,
+    0.137114355f, 0.141721465f, 0.146403984f, 0.151161691f,
+    0.15599434f, 0.160901648f, 0.165883309f, 0.170938988f,
+    0.176068324f, 0.181270926f, 0.186546371f, 0.191894211f,
+    0.197313969f, 0.202805141f, 0.208367195f, 0.21399957f,
+    0.219701672f, 0.225472883f, 0.231312559f, 0.237220023f,
+    0.243194574f, 0.249235477f, 0.255341973f, 0.261513273f,
+    0.267748559f, 0.274046988f, 0.280407688f, 0.286829754f,
+    0.293312258f, 0.299854238f, 0.306454711f, 0.31311266f,
+    0.319827043f, 0.326596789f, 0.333420797f, 0.340297937f,
+    0.347227055f, 0.354206961f, 0.361236445f, 0.368314266f,
+    0.375439152f, 0.382609809f, 0.389824902f, 0.397083078f,
+    0.404382957f, 0.411723129f, 0.419102148f, 0.426518547f,
+    0.433970828f, 0.441457469f, 0.448976914f, 0.456527582f,
+    0.464107863f, 0.471716117f, 0.47935068f, 0.487009855f,
+    0.494691922f, 0.502395125f, 0.510117684f, 0.517857789f,
+    0.525613605f, 0.53338327f, 0.541164883f, 0.548956523f,
+    0.556756246f, 0.56456207f, 0.572371988f, 0.580183965f,
+    0.587996457f
+};
+
+static const float kCubicSatF2[129] = {
+    0.f, 9.91821289e-08f, 7.93467204e-07f, 2.67798869e-06f,
+    6.3478597e-06f, 1.23982137e-05f, 2.14241638e-05f, 3.40208435e-05f,
+    5.07833659e-05f, 7.23068644e-05f, 9.91864522e-05f, 0.000132017263f,
+    0.000171394409f, 0.000217913025f, 0.000272168223f, 0.000334755137f,
+    0.00040626888f, 0.000487304586f, 0.000578457367f, 0.000680322357f,
+    0.00079349467f, 0.000918569438f, 0.00105614177f, 0.00120680681f,
+    0.00137115967f, 0.00154979547f, 0.00174330934f, 0.0019522964f,
+    0.00217735177f, 0.00241907058f, 0.00267804794f, 0.002954879f,
+    0.00325015885f, 0.00356448265f, 0.00389844549f, 0.00425264251f,
+    0.00462766882f, 0.00502411957f, 0.00544258985f, 0.00588367481f,
+    0.00634796956f, 0.00683606923f, 0.00734856894f, 0.00788606381f,
+    0.00844914897f, 0.00903841954f, 0.00965447063f, 0.0102978974f,
+    0.0109692949f, 0.0116692584f, 0.0123983828f, 0.0131572634f,
+    0.0139464953f, 0.0147666736f, 0.0156183934f, 0.0165022498f,
+    0.0174188379f, 0.0183687523f, 0.0193525873f, 0.0203709362f,
+    0.0214243916f, 0.0225135449f, 0.0236389859f, 0.0248013029f,
+    0.0260010825f, 0.0272389089f, 0.0285153644f, 0.0298310284f,
+    0.0311864779f, 0.0325822868f, 0.0340190258f, 0.0354972623f,
+    0.0370175601f, 0.0385804791f, 0.040186575f, 0.0418363996f,
+    0.0435304999f, 0.0452694182f, 0.047053692f, 0.0488838535f,
+    0.0507604296f, 0.0526839415f, 0.0546549047f, 0.0566738286f,
+    0.0587412162f, 0.0608575642f, 0.0630233626f, 0.0652390942f,
+    0.0675052349f, 0.0698222531f, 0.0721906097f, 0.0746107576f,
+    0.0770831419f, 0.0796081993f, 0.0821863581f, 0.0848180377f,
+    0.0875036487f, 0.0902435927f, 0.0930382616f, 0.095888038f,
+    0.0987932945f, 0.101754394f, 0.104771689f, 0.10784552f,
+    0.11097622f, 0.114164109f, 0.117409495f, 0.120712677f,
+    0.124073941f, 0.127493561f, 0.130971799f, 0.134508907f,
+    0.13810512f, 0.141760665f, 0.145475753f, 0.149250583f,
+    0.153085341f, 0.1569802f, 0.160935316f, 0.164950834f,
+    0.169026885f, 0.173163583f, 0.177361029f, 0.18161931f,
+    0.185938496f, 0.190318642f, 0.194759789f, 0.19926196f,
+    0.203825165f
+};
+
+static const float kSchetzenF0[129] = {
+    0.f, 0.015748f, 0.031496f, 0.047244f,
+    0.062992f, 0.07874f, 0.094488f, 0.110236f,
+    0.125984f, 0.141732f, 0.15748f, 0.173228f,
+    0.188976f, 0.204724f, 0.220472f, 0.23622f,
+    0.251969f, 0.267717f, 0.283465f, 0.299213f,
+    0.314961f, 0.330709f, 0.346457f, 0.362205f,
+    0.377953f, 0.393701f, 0.409449f, 0.425197f,
+    0.440945f, 0.456693f, 0.472441f, 0.488189f,
+    0.503937f, 0.519685f, 0.535433f, 0.551181f,
+    0.566929f, 0.582677f, 0.598425f, 0.614173f,
+    0.629921f, 0.645669f, 0.661417f, 0.677083f,
+    0.692397f, 0.707339f, 0.721909f, 0.736107f,
+    0.749933f, 0.763387f, 0.776469f, 0.789179f,
+    0.801517f, 0.813483f, 0.825077f, 0.836299f,
+    0.847149f, 0.857627f, 0.867733f, 0.877467f,
+    0.886829f, 0.895819f, 0.904437f, 0.912683f,
+    0.920557f, 0.928059f, 0.935189f, 0.941947f,
+    0.948333f, 0.954347f, 0.959989f, 0.965259f,
+    0.970157f, 0.974683f, 0.978837f, 0.982619f,
+    0.986029f, 0.989067f, 0.991733f, 0.994027f,
+    0.995949f, 0.997499f, 0.998677f, 0.999483f,
+    0.999917f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f, 1.f, 1.f, 1.f,
+    1.f
+};
+
+static const float kSchetzenF1[129] = {
+    0.f, 6.1515625e-05f, 0.0002460625f, 0.000553640625f,
+    0.00098425f, 0.00153789063f, 0.0022145625f, 0.00301426563f,
+    0.003937f, 0.00498276563f, 0.0061515625f, 0.00744339063f,
+    0.00885825f, 0.0103961406f, 0.0120570625f, 0.0138410156f,
+    0.0157480039f, 0.0177780273f, 0.019931082f, 0.022207168f,
+    0.0246062852f, 0.0271284336f, 0.0297736133f, 0.0325418242f,
+    0.0354330664f, 0.0384473398f, 0.0415846445f, 0.0448449805f,
+    0.0482283477f, 0.0517347461f, 0.0553641758f, 0.0591166367f,
+    0.0629921289f, 0.0669906523f, 0.071112207f, 0.075356793f,
+    0.0797244102f, 0.0842150586f, 0.0888287383f, 0.0935654492f,
+    0.0984251914f, 0.103407965f, 0.10851377f, 0.113742285f,
+    0.119091816f, 0.124559535f, 0.130142535f, 0.13583791f,
+    0.141642754f, 0.14755416f, 0.153569223f, 0.159685035f,
+    0.165898691f, 0.172207285f, 0.17860791f, 0.18509766f,
+    0.191673629f, 0.19833291f, 0.205072598f, 0.211889785f,
+    0.218781566f, 0.225745035f, 0.232777285f, 0.23987541f,
+    0.247036504f, 0.25425766f, 0.261535973f, 0.268868535f,
+    0.276252441f, 0.283684785f, 0.29116266f, 0.29868316f,
+    0.306243379f, 0.31384041f, 0.321471348f, 0.329133285f,
+    0.336823316f, 0.344538535f, 0.352276035f, 0.36003291f,
+    0.367806254f, 0.37559316f, 0.383390723f, 0.391196035f,
+    0.399006191f, 0.406818367f, 0.414630867f, 0.422443367f,
+    0.430255867f, 0.438068367f, 0.445880867f, 0.453693367f,
+    0.461505867f, 0.469318367f, 0.477130867f, 0.484943367f,
+    0.492755867f, 0.500568367f, 0.508380867f, 0.516193367f,
+    0.524005867f, 0.531818367f, 0.539630867f, 0.547443367f,
+    0.555255867f, 0.563068367f, 0.570880867f, 0.578693367f,
+    0.586505867f, 0.594318367f, 0.602130867f, 0.609943367f,
+    0.617755867f, 0.625568367f, 0.633380867f, 0.641193367f,
+    0.649005867f, 0.656818367f, 0.664630867f, 0.672443367f,
+    0.680255867f, 0.688068367f, 0.695880867f, 0.703693367f,
+    0.711505867f, 0.719318367f, 0.727130867f, 0.734943367f,
+    0.742755867f
+};
+
+static const float kSchetzenF2[129] = {
+    0.f, 1.6019694e-07f, 1.28157552e-06f, 4.32531738e-06f,
+    1.02526042e-05f, 2.00246175e-05f, 3.46025391e-05f, 5.49475505e-05f,
+    8.20208333e-05f, 0.000116783569f, 0.00016019694f, 0.000213222127f,
+    0.000276820313f, 0.000351952677f, 0.000439580404f, 0.000540664673f,
+    0.000656166677f, 0.000787047638f, 0.000934268748f, 0.00109879119f,
+    0.00128157614f, 0.00148358479f, 0.00170577831f, 0.00194911789f,
+    0.00221456471f, 0.00250307995f, 0.00281562479f, 0.00315316041f,
+    0.003516648f, 0.00390704874f, 0.0043253238f, 0.00477243438f,
+    0.00524934164f, 0.00575700679f, 0.00629639098f, 0.00686845541f,
+    0.00747416127f, 0.00811446972f, 0.00879034195f, 0.00950273915f,
+    0.0102526225f, 0.0110409532f, 0.0118686923f, 0.0127368004f,
+    0.0136462307f, 0.0145979178f, 0.0155927736f, 0.0166316875f,
+    0.0177155261f, 0.0188451331f, 0.0200213297f, 0.0212449145f,
+    0.0225166632f, 0.0238373288f, 0.0252076417f, 0.0266283095f,
+    0.0281000172f, 0.0296234269f, 0.0311991783f, 0.0328278881f,
+    0.0345101504f, 0.0362465368f, 0.0380375957f, 0.0398838534f,
+    0.041785813f, 0.0437439552f, 0.0457587378f, 0.047830596f,
+    0.0499599424f, 0.0521471666f, 0.0543926357f, 0.0566966941f,
+    0.0590596635f, 0.0614818428f, 0.0639635082f, 0.0665049133f,
+    0.069106289f, 0.0717678432f, 0.0744897616f, 0.0772722067f,
+    0.0801153187f, 0.0830192148f, 0.0859839896f, 0.089009715f,
+    0.0920964402f, 0.095244192f, 0.0984529781f, 0.101722799f,
+    0.105053656f, 0.108445547f, 0.111898474f, 0.115412436f,
+    0.118987433f, 0.122623465f, 0.126320532f, 0.130078635f,
+    0.133897772f, 0.137777945f, 0.141719153f, 0.145721396f,
+    0.149784674f, 0.153908988f, 0.158094336f, 0.16234072f,
+    0.166648139f, 0.171016593f, 0.175446082f, 0.179936607f,
+    0.184488166f, 0.189100761f, 0.193774391f, 0.198509056f,
+    0.203304756f, 0.208161491f, 0.213079262f, 0.218058067f,
+    0.223097908f, 0.228198784f, 0.233360695f, 0.238583641f,
+    0.243867622f, 0.249212639f, 0.254618691f, 0.260085778f,
+    0.2656139f, 0.271203057f, 0.276853249f, 0.282564477f,
+    0.288336739f
+};
+
+static const float kTanhF0[129] = {
+    0.f, 0.0312398314f, 0.0624187467f, 0.093476304f,
+    0.124353002f, 0.15499073f, 0.1853332f, 0.21532634f,
+    0.244918662f, 0.274061589f, 0.302709729f, 0.330821117f,
+    0.358357398f, 0.385283966f, 0.411570056f, 0.437188785f,
+    0.462117157f, 0.486336017f, 0.509829974f, 0.532587286f,
+    0.554599722f, 0.575862391f, 0.596373555f, 0.616134427f,
+    0.635148952f, 0.653423588f, 0.670967074f, 0.687790205f,
+    0.703905604f, 0.719327501f, 0.73407152f, 0.74815447f,
+    0.761594156f, 0.774409187f, 0.786618812f, 0.798242755f,
+    0.80930107f, 0.819814012f, 0.82980191f, 0.839285062f,
+    0.84828364f, 0.856817601f, 0.864906618f, 0.872570011f,
+    0.8798267f, 0.886695149f, 0.89319334f, 0.899338735f,
+    0.905148254f, 0.910638259f, 0.915824544f, 0.920722322f,
+    0.925346225f, 0.929710307f, 0.933828043f, 0.937712339f,
+    0.941375538f, 0.944829436f, 0.948085286f, 0.95115382f,
+    0.95404526f, 0.956769334f, 0.959335293f, 0.961751926f,
+    0.96402758f, 0.966170173f, 0.968187217f, 0.970085827f,
+    0.971872746f, 0.973554356f, 0.975136698f, 0.976625484f,
+    0.978026115f, 0.979343695f, 0.980583047f, 0.981748725f,
+    0.982845029f, 0.983876017f, 0.984845517f, 0.985757143f,
+    0.986614298f, 0.987420196f, 0.988177862f, 0.988890151f,
+    0.989559749f, 0.990189189f, 0.990780856f, 0.991336996f,
+    0.991859725f, 0.992351033f, 0.992812795f, 0.993246775f,
+    0.993654634f, 0.994037935f, 0.994398146f, 0.994736652f,
+    0.995054754f, 0.995353675f, 0.995634567f, 0.995898513f,
+    0.996146531f, 0.996379578f, 0.996598555f, 0.996804309f,
+    0.996997635f, 0.997179283f, 0.997349955f, 0.997510313f,
+    0.997660979f, 0.997802538f, 0.997935538f, 0.998060496f,
+    0.998177898f, 0.998288199f, 0.998391828f, 0.998489189f,
+    0.998580659f, 0.998666595f, 0.998747332f, 0.998823182f,
+    0.998894443f, 0.99896139f, 0.999024286f, 0.999083374f,
+    0.999138886f, 0.999191037f, 0.999240031f, 0.999286059f,
+    0.9993293f
+};
+
+static const float kTanhF1[129] = {
+    0.f, 0.000488122366f, 0.00195153765f, 0.00438739782f,
+    0.00779098072f, 0.0121557265f, 0.0174732879f, 0.0237335933f,
+    0.0309249214f, 0.0390339878f, 0.0480460397f, 0.0579449592f,
+    0.0687133735f, 0.0803327698f, 0.0927836139f, 0.106045471f,
+    0.120097126f, 0.134916707f, 0.150481801f, 0.16676957f,
+    0.183756867f, 0.201420338f, 0.219736524f, 0.238681962f,
+    0.258233265f, 0.27836721f, 0.299060815f, 0.320291397f,
+    0.342036644f, 0.364274661f, 0.386984021f, 0.410143802f,
+    0.433733624f, 0.457733677f, 0.482124739f, 0.506888201f,
+    0.532006073f, 0.557460997f, 0.583236245f, 0.609315729f,
+    0.63568399f, 0.662326197f, 0.689228138f, 0.71637621f,
+    0.743757409f, 0.771359313f, 0.799170071f, 0.827178384f,
+    0.855373493f, 0.883745158f, 0.912283639f, 0.940979684f,
+    0.969824505f, 0.998809763f, 1.02792755f, 1.05717037f,
+    1.08653112f, 1.11600307f, 1.14557986f, 1.17525547f,
+    1.20502421f, 1.23488069f, 1.26481982f, 1.29483681f,
+    1.32492711f, 1.35508645f, 1.38531079f, 1.4155963f,
+    1.44593941f, 1.47633671f, 1.506785f, 1.53728129f,
+    1.56782272f, 1.59840662f, 1.62903048f, 1.65969191f,
+    1.69038869f, 1.7211187f, 1.75187998f, 1.78267065f,
+    1.81348895f, 1.84433324f, 1.87520196f, 1.90609365f,
+    1.93700693f, 1.9679405f, 1.99889316f, 2.02986375f,
+    2.0608512f, 2.09185449f, 2.12287268f, 2.15390486f,
+    2.18495019f, 2.21600789f, 2.2470772f, 2.27815743f,
+    2.30924792f, 2.34034806f, 2.37145725f, 2.40257495f,
+    2.43370066f, 2.46483388f, 2.49597416f, 2.52712108f,
+    2.55827423f, 2.58943325f, 2.62059777f, 2.65176746f,
+    2.68294201f, 2.71412113f, 2.74530454f, 2.77649197f,
+    2.8076832f, 2.83887798f, 2.87007611f, 2.90127737f,
+    2.93248159f, 2.96368858f, 2.99489817f, 3.02611021f,
+    3.05732455f, 3.08854105f, 3.11975957f, 3.15098f,
+    3.18220223f, 3.21342613f, 3.24465162f, 3.27587859f,
+    3.30710695f
+};
+
+static const float kTanhF2[129] = {
+    0.f, 5.08460798e-06f, 4.06669491e-05f, 0.000137185345f,
+    0.000324959758f, 0.000634133754f, 0.00109461783f, 0.0017360345f,
+    0.00258766556f, 0.00367840186f, 0.0050366959f, 0.00669051755f,
+    0.00866731309f, 0.0109939678f, 0.0136967721f, 0.0168013917f,
+    0.0203328411f, 0.0243154613f, 0.028772901f, 0.0337281017f,
+    0.0392032859f, 0.0452199494f, 0.0517988562f, 0.0589600369f,
+    0.0667227899f, 0.0751056851f, 0.0841265703f, 0.0938025795f,
+    0.104150144f, 0.115185003f, 0.12692222f, 0.139376196f,
+    0.152560687f, 0.166488821f, 0.181173115f, 0.196625496f,
+    0.212857319f, 0.229879387f, 0.247701968f, 0.266334821f,
+    0.285787209f, 0.306067924f, 0.327185302f, 0.349147247f,
+    0.371961244f, 0.395634384f, 0.420173376f, 0.445584571f,
+    0.471873971f, 0.499047253f, 0.527109781f, 0.556066622f,
+    0.585922561f, 0.616682117f, 0.648349552f, 0.680928891f,
+    0.714423928f, 0.748838244f, 0.784175212f, 0.820438015f,
+    0.857629649f, 0.895752942f, 0.934810553f, 0.974804992f,
+    1.01573862f, 1.05761366f, 1.1004322f, 1.14419622f,
+    1.18890757f, 1.23456799f, 1.28117914f, 1.32874256f,
+    1.37725969f, 1.42673192f, 1.47716052f, 1.52854672f,
+    1.58089164f, 1.63419635f, 1.68846188f, 1.74368916f,
+    1.79987908f, 1.85703249f, 1.91515017f, 1.97423285f,
+    2.03428124f, 2.095296f, 2.15727772f, 2.220227f,
+    2.28414438f, 2.34903037f, 2.41488544f, 2.48171006f,
+    2.54950463f, 2.61826957f, 2.68800525f, 2.75871201f,
+    2.8303902f, 2.90304011f, 2.97666204f, 3.05125627f,
+    3.12682306f, 3.20336264f, 3.28087525f, 3.3593611f,
+    3.43882038f, 3.5192533f, 3.60066002f, 3.68304071f,
+    3.76639554f, 3.85072464f, 3.93602815f, 4.02230621f,
+    4.10955894f, 4.19778645f, 4.28698885f, 4.37716624f,
+    4.46831871f, 4.56044637f, 4.65354928f, 4.74762753f,
+    4.84268119f, 4.93871033f, 5.03571503f, 5.13369533f,
+    5.2326513f, 5.33258298f, 5.43349045f, 5.53537373f,
+    5.63823287f
+};
+
+static const float kFastTanhRestF0[129] = {
+    0.f, 0.164736165f, 0.31840796f, 0.45229682f,
+    0.561403509f, 0.644511581f, 0.703296703f, 0.741108354f,
+    0.761904762f, 0.769539078f, 0.767386091f, 0.75821217f,
+    0.744186047f, 0.726955002f, 0.707740916f, 0.687432868f,
+    0.666666667f, 0.645888988f, 0.625407166f, 0.605426936f,
+    0.586080586f, 0.567447752f, 0.549570648f, 0.532465184f,
+    0.516129032f, 0.500547474f, 0.485697607f, 0.471551371f,
+    0.45807771f, 0.445244093f, 0.433017591f, 0.421365615f,
+    0.41025641f, 0.399659381f, 0.389545292f, 0.379886373f,
+    0.370656371f, 0.361830545f, 0.353385644f, 0.345299855f,
+    0.337552743f, 0.330125181f, 0.322999279f, 0.316158309f,
+    0.309586631f, 0.303269626f, 0.29719362f, 0.291345828f,
+    0.285714286f, 0.280287796f, 0.275055871f, 0.270008686f,
+    0.26513703f, 0.260432262f, 0.255886273f, 0.251491444f,
+    0.247240618f, 0.243127062f, 0.23914444f, 0.235286787f,
+    0.23154848f, 0.22792422f, 0.224409004f, 0.220998109f,
+    0.217687075f, 0.214471683f, 0.211347944f, 0.208312079f,
+    0.205360513f, 0.202489855f, 0.199696889f, 0.196978564f,
+    0.194331984f, 0.191754397f, 0.189243187f, 0.186795867f,
+    0.18441007f, 0.182083541f, 0.179814134f, 0.177599803f,
+    0.175438596f, 0.173328652f, 0.171268194f, 0.169255524f,
+    0.167289022f, 0.165367136f, 0.163488386f, 0.161651352f,
+    0.159854678f, 0.158097062f, 0.15637726f, 0.154694078f,
+    0.153046371f, 0.151433042f, 0.149853036f, 0.148305343f,
+    0.146788991f, 0.145303046f, 0.143846613f, 0.142418827f,
+    0.141018861f, 0.139645916f, 0.138299225f, 0.136978047f,
+    0.13568167f, 0.134409409f, 0.133160601f, 0.131934611f,
+    0.130730822f, 0.129548641f, 0.128387497f, 0.127246836f,
+    0.126126126f, 0.125024851f, 0.123942514f, 0.122878632f,
+    0.121832743f, 0.120804395f, 0.119793154f, 0.118798599f,
+    0.117820324f, 0.116857934f, 0.115911048f, 0.114979296f,
+    0.11406232f, 0.113159775f, 0.112271322f, 0.111396638f,
+    0.110535406f
+};
+
+static const float kFastTanhRestF1[129] = {
+    0.f, 0.0154440154f, 0.0607387772f, 0.13299235f,
+    0.228026756f, 0.341081296f, 0.467438322f, 0.602851297f,
+    0.743758776f, 0.887331636f, 1.03141837f, 1.17444321f,
+    1.31529304f, 1.45321251f, 1.58771526f, 1.7185128f,
+    1.84545963f, 1.96851172f, 2.08769574f, 2.20308643f,
+    2.31479026f, 2.42293355f, 2.52765402f, 2.62909488f,
+    2.72740059f, 2.82271401f, 2.91517449f, 3.00491658f,
+    3.0920693f, 3.17675572f, 3.25909276f, 3.33919118f,
+    3.41715575f, 3.49308535f, 3.56707329f, 3.63920751f,
+    3.70957089f, 3.77824154f, 3.84529306f, 3.91079482f,
+    3.97481225f, 4.03740706f, 4.09863748f, 4.1585585f,
+    4.21722209f, 4.27467736f, 4.33097079f, 4.38614637f,
+    4.44024575f, 4.49330845f, 4.54537192f, 4.59647172f,
+    4.64664163f, 4.69591375f, 4.74431861f, 4.79188527f,
+    4.8386414f, 4.88461337f, 4.92982633f, 4.97430425f,
+    5.01807006f, 5.06114563f, 5.10355187f, 5.14530878f,
+    5.18643552f, 5.2269504f, 5.26687099f, 5.30621412f,
+    5.34499593f, 5.3832319f, 5.4209369f, 5.45812523f,
+    5.49481059f, 5.53100619f, 5.56672471f, 5.60197838f,
+    5.63677893f, 5.67113771f, 5.70506561f, 5.73857317f,
+    5.77167052f, 5.80436745f, 5.83667341f, 5.8685975f,
+    5.90014856f, 5.93133507f, 5.96216528f, 5.99264713f,
+    6.02278832f, 6.05259629f, 6.08207826f, 6.1112412f,
+    6.14009186f, 6.16863681f, 6.19688238f, 6.22483473f,
+    6.25249982f, 6.27988345f, 6.30699123f, 6.33382862f,
+    6.3604009f, 6.38671322f, 6.41277058f, 6.43857782f,
+    6.46413967f, 6.48946071f, 6.5145454f, 6.53939807f,
+    6.56402296f, 6.58842416f, 6.61260567f, 6.63657139f,
+    6.6603251f, 6.68387051f, 6.7072112f, 6.73035068f,
+    6.75329237f, 6.7760396f, 6.79859563f, 6.8209636f,
+    6.84314663f, 6.86514771f, 6.8869698f, 6.90861577f,
+    6.93008843f, 6.9513905f, 6.97252466f, 6.99349353f,
+    7.01429966f
+};
+
+static const float kFastTanhRestF2[129] = {
+    0.f, 0.000965250965f, 0.00765717743f, 0.0254272181f,
+    0.0589531108f, 0.11206351f, 0.187690002f, 0.287918878f,
+    0.414102645f, 0.566995005f, 0.746884126f, 0.953710525f,
+    1.18716439f, 1.44676227f, 1.73190554f, 2.04192391f,
+    2.37610717f, 2.73372785f, 3.11405731f, 3.51637667f,
+    3.93998429f, 4.38420049f, 4.84837045f, 5.33186577f,
+    5.83408508f, 6.35445397f, 6.89242452f, 7.44747451f,
+    8.01910641f, 8.60684635f, 9.21024297f, 9.82886622f,
+    10.4623063f, 11.1101724f, 11.7720919f, 12.4477091f,
+    13.1366841f, 13.8386924f, 14.5534235f, 15.2805804f,
+    16.0198788f, 16.7710461f, 17.5338211f, 18.3079533f,
+    19.093202f, 19.8893361f, 20.6961334f, 21.5133802f,
+    22.340871f, 23.1784076f, 24.0257992f, 24.8828618f,
+    25.749418f, 26.6252963f, 27.5103314f, 28.4043634f,
+    29.3072378f, 30.2188049f, 31.1389203f, 32.0674439f,
+    33.0042399f, 33.949177f, 34.9021277f, 35.8629684f,
+    36.8315791f, 37.8078435f, 38.7916484f, 39.782884f,
+    40.7814436f, 41.7872233f, 42.8001224f, 43.8200424f,
+    44.8468879f, 45.8805658f, 46.9209854f, 47.9680585f,
+    49.021699f, 50.081823f, 51.1483487f, 52.2211963f,
+    53.300288f, 54.3855477f, 55.4769013f, 56.5742764f,
+    57.6776021f, 58.7868093f, 59.9018305f, 61.0225995f,
+    62.1490518f, 63.2811243f, 64.4187551f, 65.5618837f,
+    66.710451f, 67.864399f, 69.0236711f, 70.1882116f,
+    71.3579662f, 72.5328815f, 73.7129052f, 74.8979863f,
+    76.0880744f, 77.2831204f, 78.4830759f, 79.6878937f,
+    80.8975272f, 82.111931f, 83.3310602f, 84.554871f,
+    85.7833203f, 87.0163657f, 88.2539656f, 89.4960793f,
+    90.7426666f, 91.9936882f, 93.2491053f, 94.5088798f,
+    95.7729744f, 97.0413523f, 98.3139773f, 99.5908139f,
+    100.871827f, 102.156983f, 103.446246f, 104.739585f,
+    106.036966f, 107.338358f, 108.643727f, 109.953044f,
+    111.266277f
+};
+
+}
+}
+/** @} */
@@ -0,0 +1,396 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    BlepOscBank.h
+ * @brief   Band-limited saw, pulse and triangle oscillators for N voices.
+ *
+ * Phases are 32 bit accumulators wrapping once per cycle, as in Vox, and
+ * voices sit in float32x4_t lanes. Discontinuities are smoothed with two
+ * sample polynomial corrections: PolyBLEP for the jumps of saw and pulse,
+ * PolyBLAMP for the corners of the triangle.
+ *
+ * Each voice can be hard synced to its own master phase. The correction for a
+ * sync reset spans the sample before the reset, so all output is delayed by
+ * one sample, with or without sync.
+ *
+ * Render functions write lane interleaved blocks: RenderX4() writes
+ * out[i * 4 + lane] for voices voice to voice + 3, RenderX1() writes out[i].
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/float_simd_approx.h"
+#include "utils/int_simd.h"
+
+namespace dsp
+{
+
+template <int N>
+class BlepOscBank
+{
+public:
+    static_assert(N % 4 == 0, "N must be a multiple of 4");
+
+    enum Waveform {
+        kSaw = 0,     // falling edge at phase 0, rising ramp
+        kPulse,       // high for phase < pulse width
+        kTriangle     // peak at phase 0
+    };
+
+    BlepOscBank()
+    {
+        Reset();
+    }
+
+    void Reset()
+    {
+        for (int v = 0; v < N; v++)
+        {
+            mPhase[v] = 0;
+            mSyncPhase[v] = 0;
+            mSyncInc[v] = 0;
+            mSyncInvDt[v] = 0.f;
+            mDelayed[v] = 0.f;
+            mPulseWidth[v] = mPulseWidthZ[v] = 0.5f;
+            SetFrequency(v, 0.f);
+        }
+    }
+
+    void ResetPhase(int voice)
+    {
+        mPhase[voice] = 0;
+        mSyncPhase[voice] = 0;
+    }
+
+    // w0 in cycles per sample, [0, 0.5)
+    void SetFrequency(int voice, float w0)
+    {
+        w0 = clipminmaxf(0.f, w0, kMaxW0);
+        mInc[voice] = static_cast<uint32_t>(w0 * kPhaseScale);
+        mDt[voice] = w0;
+        mInvDt[voice] = 1.f / clipminf(kMinW0, w0);
+    }
+
+    fast_inline void SetFrequencyX4(int voice, float32x4_t w0)
+    {
+        w0 = clipminmaxfx4(f32x4_dup(0.f), w0, f32x4_dup(kMaxW0));
+        u32x4_str(&mInc[voice], si_f32x4_to_u32x4(float32x4_mulscal(w0, kPhaseScale)));
+        f32x4_str(&mDt[voice], w0);
+        f32x4_str(&mInvDt[voice], float32x4_rcp_nr(clipminfx4(f32x4_dup(kMinW0), w0)));
+    }
+
+    // Ramped over the next rendered block, clipped to [0.02, 0.98]
+    void SetPulseWidth(int voice, float pw)
+    {
+        mPulseWidth[voice] = clipminmaxf(0.02f, pw, 0.98f);
+    }
+
+    // Frequency of the master phase the voice is reset by, 0 disables sync
+    void SetSyncFrequency(int voice, float w0)
+    {
+        w0 = clipminmaxf(0.f, w0, kMaxW0);
+        mSyncInc[voice] = static_cast<uint32_t>(w0 * kPhaseScale);
+        mSyncInvDt[voice] = (w0 > 0.f) ? 1.f / clipminf(kMinW0, w0) : 0.f;
+    }
+
+    /*===========================================================================*/
+    /* Rendering. */
+    /*===========================================================================*/
+
+    template <int Waveform>
+    void RenderX4(int voice, float * out, size_t frames)
+    {
+        uint32x4_t phase = u32x4_ld(&mPhase[voice]);
+        const uint32x4_t inc = u32x4_ld(&mInc[voice]);
+        const float32x4_t dt = f32x4_ld(&mDt[voice]);
+        const float32x4_t invDt = f32x4_ld(&mInvDt[voice]);
+        uint32x4_t syncPhase = u32x4_ld(&mSyncPhase[voice]);
+        const uint32x4_t syncInc = u32x4_ld(&mSyncInc[voice]);
+        const float32x4_t syncInvDt = f32x4_ld(&mSyncInvDt[voice]);
+        const uint32x4_t syncOn = uint32x4_gt(syncInc, u32x4_dup(0));
+        float32x4_t delayed = f32x4_ld(&mDelayed[voice]);
+
+        float32x4_t pw = f32x4_ld(&mPulseWidthZ[voice]);
+        const float32x4_t pwDelta = float32x4_mulscal(float32x4_sub(f32x4_ld(&mPulseWidth[voice]), pw), 1.f / frames);
+
+        const float32x4_t zero = f32x4_dup(0.f);
+        const float32x4_t one = f32x4_dup(1.f);
+
+        for (size_t i = 0; i < frames; i++)
+        {
+            pw = float32x4_add(pw, pwDelta);
+
+            // master wrapped during this sample: d is the time since the wrap in samples
+            syncPhase = uint32x4_add(syncPhase, syncInc);
+            const uint32x4_t reset = uint32x4_and(syncOn, uint32x4_lt(syncPhase, syncInc));
+            const float32x4_t d = clipmaxfx4(float32x4_mul(PhaseToFloatX4(syncPhase), syncInvDt), f32x4_dup(0.99999f));
+
+            // slave phase at the reset, then restart from there
+            const float32x4_t tReset = PhaseToFloatX4(uint32x4_add(phase, si_f32x4_to_u32x4(float32x4_mul(float32x4_sub(one, d), float32x4_mulscal(dt, kPhaseScale)))));
+            const uint32x4_t restarted = si_f32x4_to_u32x4(float32x4_mul(d, float32x4_mulscal(dt, kPhaseScale)));
+            phase = uint32x4_sel(reset, restarted, uint32x4_add(phase, inc));
+
+            const float32x4_t t = PhaseToFloatX4(phase);
+            float32x4_t y = NaiveX4<Waveform>(t, pw);
+            y = float32x4_add(y, CorrectionX4<Waveform>(t, pw, dt, invDt));
+
+            // jump at the reset, minus the part the regular correction already covers at phase 0
+            const float32x4_t jump = float32x4_sub(NaiveX4<Waveform>(zero, pw), NaiveX4<Waveform>(tReset, pw));
+            const float32x4_t extra = float32x4_sub(jump, f32x4_dup(JumpAtZero<Waveform>()));
+            const float32x4_t dd = float32x4_sub(one, d);
+            const float32x4_t before = float32x4_mulscal(float32x4_mul(jump, float32x4_mul(d, d)), 0.5f);
+            const float32x4_t after = float32x4_mulscal(float32x4_mul(extra, float32x4_mul(dd, dd)), -0.5f);
+            delayed = float32x4_add(delayed, float32x4_sel(reset, before, zero));
+            y = float32x4_add(y, float32x4_sel(reset, after, zero));
+
+            f32x4_str(&out[i * 4], delayed);
+            delayed = y;
+        }
+
+        u32x4_str(&mPhase[voice], phase);
+        u32x4_str(&mSyncPhase[voice], syncPhase);
+        f32x4_str(&mDelayed[voice], delayed);
+        f32x4_str(&mPulseWidthZ[voice], pw);
+    }
+
+    template <int Waveform>
+    void RenderX1(int voice, float * out, size_t frames)
+    {
+        uint32_t phase = mPhase[voice];
+        const uint32_t inc = mInc[voice];
+        const float dt = mDt[voice];
+        const float invDt = mInvDt[voice];
+        uint32_t syncPhase = mSyncPhase[voice];
+        const uint32_t syncInc = mSyncInc[voice];
+        const float syncInvDt = mSyncInvDt[voice];
+        float delayed = mDelayed[voice];
+
+        float pw = mPulseWidthZ[voice];
+        const float pwDelta = (mPulseWidth[voice] - pw) / frames;
+
+        for (size_t i = 0; i < frames; i++)
+        {
+            pw += pwDelta;
+
+            syncPhase += syncInc;
+            const bool reset = (syncInc > 0) && (syncPhase < syncInc);
+            float before = 0.f;
+            float after = 0.f;
+            if (reset)
+            {
+                const float d = clipmaxf(PhaseToFloat(syncPhase) * syncInvDt, 0.99999f);
+                const float tReset = PhaseToFloat(phase + static_cast<uint32_t>((1.f - d) * dt * kPhaseScale));
+                phase = static_cast<uint32_t>(d * dt * kPhaseScale);
+
+                const float jump = Naive<Waveform>(0.f, pw) - Naive<Waveform>(tReset, pw);
+                before = 0.5f * jump * d * d;
+                after = -0.5f * (jump - JumpAtZero<Waveform>()) * (1.f - d) * (1.f - d);
+            }
+            else
+            {
+                phase += inc;
+            }
+
+            const float t = PhaseToFloat(phase);
+            const float y = Naive<Waveform>(t, pw) + Correction<Waveform>(t, pw, dt, invDt) + after;
+
+            out[i] = delayed + before;
+            delayed = y;
+        }
+
+        mPhase[voice] = phase;
+        mSyncPhase[voice] = syncPhase;
+        mDelayed[voice] = delayed;
+        mPulseWidthZ[voice] = pw;
+    }
+
+private:
+    static constexpr float kPhaseScale = 4294967296.f;       // 2^32
+    static constexpr float kPhaseScaleRecip = 2.3283064e-10f; // 2^-32
+    static constexpr float kMaxW0 = 0.49f;
+    static constexpr float kMinW0 = 1e-7f;
+
+    static fast_inline float PhaseToFloat(uint32_t phase)
+    {
+        return static_cast<float>(phase) * kPhaseScaleRecip;
+    }
+
+    static fast_inline float32x4_t PhaseToFloatX4(uint32x4_t phase)
+    {
+        return float32x4_mulscal(si_u32x4_to_f32x4(phase), kPhaseScaleRecip);
+    }
+
+    // t in [0, 1)
+    static fast_inline float Wrap(float t)
+    {
+        return (t < 0.f) ? t + 1.f : t;
+    }
+
+    static fast_inline float32x4_t WrapX4(float32x4_t t)
+    {
+        return float32x4_sel(float32x4_ltz(t), float32x4_addscal(t, 1.f), t);
+    }
+
+    // value jump of the naive waveform at phase 0
+    template <int Waveform>
+    static constexpr float JumpAtZero()
+    {
+        return (Waveform == kSaw) ? -2.f : (Waveform == kPulse) ? 2.f : 0.f;
+    }
+
+    /*===========================================================================*/
+    /* Naive waveforms. */
+    /*===========================================================================*/
+
+    template <int Waveform>
+    static fast_inline float Naive(float t, float pw)
+    {
+        if (Waveform == kSaw)
+            return 2.f * t - 1.f;
+        if (Waveform == kPulse)
+            return (t < pw) ? 1.f : -1.f;
+        return 2.f * si_fabsf(2.f * t - 1.f) - 1.f;
+    }
+
+    template <int Waveform>
+    static fast_inline float32x4_t NaiveX4(float32x4_t t, float32x4_t pw)
+    {
+        if (Waveform == kSaw)
+            return float32x4_fmulscaladd(f32x4_dup(-1.f), t, 2.f);
+        if (Waveform == kPulse)
+            return float32x4_sel(float32x4_lt(t, pw), f32x4_dup(1.f), f32x4_dup(-1.f));
+        return float32x4_fmulscaladd(f32x4_dup(-1.f), si_fabsfx4(float32x4_fmulscaladd(f32x4_dup(-1.f), t, 2.f)), 2.f);
+    }
+
+    /*===========================================================================*/
+    /* Corrections. */
+    /*===========================================================================*/
+
+    // residual of a unit step at phase 0, covers t < dt and t > 1 - dt
+    static fast_inline float Blep(float t, float dt, float invDt)
+    {
+        if (t < dt)
+        {
+            const float x = t * invDt;
+            return x + x - x * x - 1.f;
+        }
+        if (t > 1.f - dt)
+        {
+            const float x = (t - 1.f) * invDt;
+            return x * x + x + x + 1.f;
+        }
+        return 0.f;
+    }
+
+    // residual of a unit slope change at phase 0, in samples
+    static fast_inline float Blamp(float t, float dt, float invDt)
+    {
+        if (t < dt)
+        {
+            const float x = t * invDt - 1.f;
+            return (-1.f / 3.f) * x * x * x;
+        }
+        if (t > 1.f - dt)
+        {
+            const float x = (t - 1.f) * invDt + 1.f;
+            return (1.f / 3.f) * x * x * x;
+        }
+        return 0.f;
+    }
+
+    static fast_inline float32x4_t BlepX4(float32x4_t t, float32x4_t dt, float32x4_t invDt)
+    {
+        const float32x4_t x0 = float32x4_mul(t, invDt);
+        const float32x4_t b0 = float32x4_sub(float32x4_mul(x0, float32x4_sub(f32x4_dup(2.f), x0)), f32x4_dup(1.f));
+        const float32x4_t x1 = float32x4_mul(float32x4_subscal(t, 1.f), invDt);
+        const float32x4_t b1 = float32x4_mul(float32x4_addscal(x1, 1.f), float32x4_addscal(x1, 1.f));
+        const float32x4_t late = float32x4_sel(float32x4_gt(t, float32x4_sub(f32x4_dup(1.f), dt)), b1, f32x4_dup(0.f));
+        return float32x4_sel(float32x4_lt(t, dt), b0, late);
+    }
+
+    static fast_inline float32x4_t BlampX4(float32x4_t t, float32x4_t dt, float32x4_t invDt)
+    {
+        const float32x4_t x0 = float32x4_subscal(float32x4_mul(t, invDt), 1.f);
+        const float32x4_t b0 = float32x4_mulscal(float32x4_mul(x0, float32x4_mul(x0, x0)), -1.f / 3.f);
+        const float32x4_t x1 = float32x4_addscal(float32x4_mul(float32x4_subscal(t, 1.f), invDt), 1.f);
+        const float32x4_t b1 = float32x4_mulscal(float32x4_mul(x1, float32x4_mul(x1, x1)), 1.f / 3.f);
+        const float32x4_t late = float32x4_sel(float32x4_gt(t, float32x4_sub(f32x4_dup(1.f), dt)), b1, f32x4_dup(0.f));
+        return float32x4_sel(float32x4_lt(t, dt), b0, late);
+    }
+
+    template <int Waveform>
+    static fast_inline float Correction(float t, float pw, float dt, float invDt)
+    {
+        if (Waveform == kSaw)
+            return -Blep(t, dt, invDt);
+        if (Waveform == kPulse)
+            return Blep(t, dt, invDt) - Blep(Wrap(t - pw), dt, invDt);
+        // slope changes by -8 per cycle at the peak and +8 at the trough
+        return 8.f * dt * (Blamp(Wrap(t - 0.5f), dt, invDt) - Blamp(t, dt, invDt));
+    }
+
+    template <int Waveform>
+    static fast_inline float32x4_t CorrectionX4(float32x4_t t, float32x4_t pw, float32x4_t dt, float32x4_t invDt)
+    {
+        if (Waveform == kSaw)
+            return float32x4_neg(BlepX4(t, dt, invDt));
+        if (Waveform == kPulse)
+            return float32x4_sub(BlepX4(t, dt, invDt), BlepX4(WrapX4(float32x4_sub(t, pw)), dt, invDt));
+        const float32x4_t blamp = float32x4_sub(BlampX4(WrapX4(float32x4_subscal(t, 0.5f)), dt, invDt), BlampX4(t, dt, invDt));
+        return float32x4_mul(float32x4_mulscal(dt, 8.f), blamp);
+    }
+
+    uint32_t mPhase[N];
+    uint32_t mInc[N];
+    float mDt[N];
+    float mInvDt[N];
+    uint32_t mSyncPhase[N];
+    uint32_t mSyncInc[N];
+    float mSyncInvDt[N];
+    float mPulseWidth[N];
+    float mPulseWidthZ[N];
+    float mDelayed[N];
+};
+
+}
+/** @} */
@@ -0,0 +1,336 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    EnvelopeBank.h
+ * @brief   N voice ADSR/AHR/AD envelope generator, four voices per float32x4_t.
+ *
+ * Every segment is the affine step level = a * level + b. A linear segment
+ * uses a = 1 and a constant slope b. An exponential segment approaches a
+ * target slightly beyond its end point (a one-pole towards an overshoot
+ * target), so it reaches the end point in the set time. Each tick, every
+ * lane picks a and b for its stage with lane masks, advances, and then
+ * moves to its next stage where its level or hold timer crossed the
+ * boundary. No lane branches, and all voices share one code path whatever
+ * their stage.
+ *
+ * A tick is one sample, or one block at control rate. SetTickRate() defines
+ * how many ticks make a second. Times are for a full scale swing, except the
+ * decay, which runs from 1 to the sustain level.
+ *
+ * OnVoiceAllocation(), OnVoiceSteal() and OnVoiceRelease() map onto the
+ * oscillator voiceEvent() callback. A triggered voice starts its attack from
+ * its current level, so stolen voices do not click.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/int_simd.h"
+
+namespace dsp
+{
+
+template <int N>
+class EnvelopeBank
+{
+public:
+    static_assert(N % 4 == 0, "N must be a multiple of 4");
+
+    enum Mode
+    {
+        kModeADSR,  // attack, decay to sustain while gated, release
+        kModeAHR,   // attack, hold for the decay time or until released, release
+        kModeAD     // one shot attack and decay to zero, release is ignored
+    };
+
+    enum Curve
+    {
+        kCurveLinear,
+        kCurveExponential
+    };
+
+    enum Stage
+    {
+        kStageIdle,
+        kStageAttack,
+        kStageDecay,
+        kStageSustain,
+        kStageHold,
+        kStageRelease
+    };
+
+    static constexpr int kGroups = N / 4;
+
+    EnvelopeBank():
+    mMode(kModeADSR),
+    mCurve(kCurveExponential),
+    mTickRate(48000.f),
+    mAttack(0.005f),
+    mDecay(0.2f),
+    mSustain(0.7f),
+    mRelease(0.3f)
+    {
+        Reset();
+        UpdateCoeffs();
+    }
+
+    // all voices idle at zero
+    void Reset()
+    {
+        for (int i = 0; i < N; i++)
+        {
+            mLevel[i] = 0.f;
+            mGain[i] = 0.f;
+            mTimer[i] = 0.f;
+            mStage[i] = kStageIdle;
+        }
+    }
+
+    /*===========================================================================*/
+    /* Parameters, shared by all voices. */
+    /*===========================================================================*/
+
+    // ticks per second, the sample rate or the sample rate divided by the block size
+    void SetTickRate(float rate) { mTickRate = rate; UpdateCoeffs(); }
+    void SetMode(Mode mode) { mMode = mode; UpdateCoeffs(); }
+    void SetCurve(Curve curve) { mCurve = curve; UpdateCoeffs(); }
+
+    /**
+     * @param attack   Attack time in seconds.
+     * @param decay    Decay time in seconds, the hold time in kModeAHR.
+     * @param sustain  Sustain level in [0, 1], only used by kModeADSR.
+     * @param release  Release time in seconds.
+     */
+    void SetTimes(float attack, float decay, float sustain, float release)
+    {
+        mAttack = attack;
+        mDecay = decay;
+        mSustain = clip01f(sustain);
+        mRelease = release;
+        UpdateCoeffs();
+    }
+
+    /*===========================================================================*/
+    /* Voice control. */
+    /*===========================================================================*/
+
+    // gain scales the output of the voice, e.g. velocity
+    void Trigger(int voice, float gain = 1.f)
+    {
+        mStage[voice] = kStageAttack;
+        mGain[voice] = gain;
+        mTimer[voice] = mHoldTicks;
+    }
+
+    void Release(int voice)
+    {
+        mStage[voice] = (mMode == kModeAD || mStage[voice] == kStageIdle) ? mStage[voice] : (uint32_t)kStageRelease;
+    }
+
+    // silences a voice immediately
+    void Kill(int voice)
+    {
+        mStage[voice] = kStageIdle;
+        mLevel[voice] = 0.f;
+    }
+
+    void OnVoiceAllocation(int voice, uint8_t velocity) { Trigger(voice, velocity * (1.f / 127.f)); }
+    void OnVoiceSteal(int voice, uint8_t velocity) { Trigger(voice, velocity * (1.f / 127.f)); }
+    void OnVoiceRelease(int voice) { Release(voice); }
+
+    uint32_t GetStage(int voice) const { return mStage[voice]; }
+
+    // bit i is set while voice i is not idle
+    uint32_t GetActiveMask() const
+    {
+        uint32_t mask = 0;
+        for (int i = 0; i < N; i++)
+            mask |= (uint32_t)(mStage[i] != kStageIdle) << i;
+        return mask;
+    }
+
+    /*===========================================================================*/
+    /* Rendering. */
+    /*===========================================================================*/
+
+    // advances all voices by one tick
+    fast_inline void Advance()
+    {
+        const float32x4_t zero = f32x4_dup(0.f);
+        const float32x4_t one = f32x4_dup(1.f);
+        const float32x4_t sustain = f32x4_dup(mSustainLevel);
+
+        for (int g = 0; g < kGroups; g++)
+        {
+            const int i = g * 4;
+            uint32x4_t stage = u32x4_ld(&mStage[i]);
+            float32x4_t level = f32x4_ld(&mLevel[i]);
+            float32x4_t timer = f32x4_ld(&mTimer[i]);
+
+            const uint32x4_t isAttack = uint32x4_eq(stage, u32x4_dup(kStageAttack));
+            const uint32x4_t isDecay = uint32x4_eq(stage, u32x4_dup(kStageDecay));
+            const uint32x4_t isHold = uint32x4_eq(stage, u32x4_dup(kStageHold));
+            const uint32x4_t isRelease = uint32x4_eq(stage, u32x4_dup(kStageRelease));
+
+            // idle, sustain and hold keep their level: a = 1, b = 0
+            float32x4_t a = float32x4_sel(isAttack, f32x4_dup(mAttackA), one);
+            a = float32x4_sel(isDecay, f32x4_dup(mDecayA), a);
+            a = float32x4_sel(isRelease, f32x4_dup(mReleaseA), a);
+            float32x4_t b = float32x4_sel(isAttack, f32x4_dup(mAttackB), zero);
+            b = float32x4_sel(isDecay, f32x4_dup(mDecayB), b);
+            b = float32x4_sel(isRelease, f32x4_dup(mReleaseB), b);
+
+            level = float32x4_fmuladd(b, level, a);
+            timer = float32x4_sub(timer, float32x4_sel(isHold, one, zero));
+
+            // attack ends at full scale
+            const uint32x4_t attackDone = uint32x4_and(isAttack, float32x4_gte(level, one));
+            level = float32x4_sel(attackDone, one, level);
+            stage = vbslq_u32(attackDone, u32x4_dup(mAfterAttack), stage);
+
+            // decay ends at the sustain level, zero in kModeAD
+            const uint32x4_t decayDone = uint32x4_and(isDecay, float32x4_lte(level, sustain));
+            level = float32x4_sel(decayDone, sustain, level);
+            stage = vbslq_u32(decayDone, u32x4_dup(mAfterDecay), stage);
+
+            const uint32x4_t holdDone = uint32x4_and(isHold, float32x4_lte(timer, zero));
+            stage = vbslq_u32(holdDone, u32x4_dup(kStageRelease), stage);
+
+            const uint32x4_t releaseDone = uint32x4_and(isRelease, float32x4_lte(level, zero));
+            level = float32x4_sel(releaseDone, zero, level);
+            stage = vbslq_u32(releaseDone, u32x4_dup(kStageIdle), stage);
+
+            u32x4_str(&mStage[i], stage);
+            f32x4_str(&mLevel[i], level);
+            f32x4_str(&mTimer[i], timer);
+        }
+    }
+
+    // output of voices first to first + 3 after the last tick, gain applied
+    fast_inline float32x4_t GetX4(int first) const
+    {
+        return float32x4_mul(f32x4_ld(&mLevel[first]), f32x4_ld(&mGain[first]));
+    }
+
+    // one tick per frame, writes frames * N outputs, voice interleaved
+    void Render(float * out, size_t frames)
+    {
+        for (size_t f = 0; f < frames; f++, out += N)
+        {
+            Advance();
+            for (int i = 0; i < N; i += 4)
+                f32x4_str(&out[i], GetX4(i));
+        }
+    }
+
+private:
+    // exponential segments aim this far beyond their end point, relative to full scale
+    static constexpr float kAttackOvershoot = 0.3f;
+    static constexpr float kDecayOvershoot = 0.0001f;  // -80 dB
+
+    void UpdateCoeffs()
+    {
+        const float attackTicks = Ticks(mAttack);
+        const float decayTicks = Ticks(mDecay);
+        const float releaseTicks = Ticks(mRelease);
+
+        mSustainLevel = (mMode == kModeADSR) ? mSustain : 0.f;
+        mAfterAttack = (mMode == kModeAHR) ? kStageHold : kStageDecay;
+        mAfterDecay = (mMode == kModeADSR) ? kStageSustain : kStageIdle;
+        mHoldTicks = decayTicks;
+
+        if (mCurve == kCurveLinear)
+        {
+            mAttackA = mDecayA = mReleaseA = 1.f;
+            mAttackB = 1.f / attackTicks;
+            mDecayB = -(1.f - mSustainLevel) / decayTicks;
+            mReleaseB = -1.f / releaseTicks;
+        }
+        else
+        {
+            mAttackA = OnePoleCoeff(attackTicks, kAttackOvershoot);
+            mDecayA = OnePoleCoeff(decayTicks, kDecayOvershoot);
+            mReleaseA = OnePoleCoeff(releaseTicks, kDecayOvershoot);
+            mAttackB = (1.f + kAttackOvershoot) * (1.f - mAttackA);
+            mDecayB = (mSustainLevel - kDecayOvershoot) * (1.f - mDecayA);
+            mReleaseB = -kDecayOvershoot * (1.f - mReleaseA);
+        }
+    }
+
+    float Ticks(float seconds) const
+    {
+        const float t = seconds * mTickRate;
+        return (t > 1.f) ? t : 1.f;
+    }
+
+    // a one-pole covering full scale plus overshoot in ticks reaches the end point on time
+    static float OnePoleCoeff(float ticks, float overshoot)
+    {
+        return expf(-logf((1.f + overshoot) / overshoot) / ticks);
+    }
+
+    float mLevel[N];
+    float mGain[N];
+    float mTimer[N];
+    uint32_t mStage[N];
+
+    Mode mMode;
+    Curve mCurve;
+    float mTickRate;
+    float mAttack;
+    float mDecay;
+    float mSustain;
+    float mRelease;
+
+    // derived by UpdateCoeffs()
+    float mAttackA, mAttackB;
+    float mDecayA, mDecayB;
+    float mReleaseA, mReleaseB;
+    float mSustainLevel;
+    float mHoldTicks;
+    uint32_t mAfterAttack;
+    uint32_t mAfterDecay;
+};
+
+}
+/** @} */
@@ -0,0 +1,287 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    ModalBank.h
+ * @brief   Bank of decaying resonant modes for bells, bars and plates.
+ *
+ * Each mode is a two-pole resonator in coupled form: the complex state z is
+ * multiplied every sample by r * e^(j * w), so it rotates at the mode's frequency
+ * and decays by r. The excitation is added to the real part of z. The mode's
+ * output is gain * Im(z), so an impulse of 1 rings as gain * r^n * sin(w * n).
+ * Four modes share a float32x4_t.
+ *
+ * The coupled form keeps its amplitude when the coefficients change, so modes
+ * can be retuned every block without clicks. It also stays accurate for low
+ * modes with long decays, where the direct form loses precision.
+ *
+ * Groups of four modes whose energy has fallen below kSilence are cleared and
+ * skipped until they are excited again.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/float_simd_approx.h"
+#include "utils/int_simd.h"
+
+namespace dsp
+{
+
+template <int N>
+class ModalBank
+{
+public:
+    static_assert(N % 4 == 0, "N must be a multiple of 4");
+
+    static constexpr int kGroups = N / 4;
+    static constexpr float kSilence = 1e-10f;   // energy, about -100 dB
+    static constexpr float kMaxW0 = 0.49f;
+    static constexpr float kMinDecay = 16.f;     // samples
+
+    ModalBank()
+    {
+        for (int m = 0; m < N; m++)
+        {
+            mCos[m] = 0.f;
+            mSin[m] = 0.f;
+            mGain[m] = 0.f;
+            mW0[m] = 0.f;
+            mDecay[m] = kMinDecay;
+            mModeGain[m] = 0.f;
+        }
+        Reset();
+    }
+
+    // silences all modes, tuning is kept
+    void Reset()
+    {
+        for (int m = 0; m < N; m++)
+        {
+            mRe[m] = 0.f;
+            mIm[m] = 0.f;
+        }
+        for (int g = 0; g < kGroups; g++)
+            mActive[g] = false;
+    }
+
+    /**
+     * @param w0     Frequency in cycles per sample, modes at or above kMaxW0 are muted.
+     * @param decay  Time to decay by 60 dB in samples.
+     * @param gain   Output gain.
+     */
+    void SetMode(int mode, float w0, float decay, float gain)
+    {
+        float w[4], d[4], a[4];
+        for (int k = 0; k < 4; k++)
+        {
+            w[k] = mW0[(mode & ~3) + k];
+            d[k] = mDecay[(mode & ~3) + k];
+            a[k] = mModeGain[(mode & ~3) + k];
+        }
+        w[mode & 3] = w0;
+        d[mode & 3] = decay;
+        a[mode & 3] = gain;
+        SetModesX4(mode & ~3, f32x4_ld(w), f32x4_ld(d), f32x4_ld(a));
+    }
+
+    // sets modes first to first + 3, first must be a multiple of 4
+    fast_inline void SetModesX4(int first, float32x4_t w0, float32x4_t decay, float32x4_t gain)
+    {
+        f32x4_str(&mW0[first], w0);
+        f32x4_str(&mDecay[first], decay);
+        f32x4_str(&mModeGain[first], gain);
+
+        const uint32x4_t audible = float32x4_lt(w0, f32x4_dup(kMaxW0));
+        w0 = clipminmaxfx4(f32x4_dup(0.f), w0, f32x4_dup(kMaxW0));
+        float32x4_t c, s;
+        fastsincosfx4(float32x4_mulscal(w0, 2.f * M_PI), &c, &s);
+
+        // r = 10^(-3 / decay) = e^(-k)
+        const float32x4_t k = float32x4_mul(f32x4_dup(6.9077553f), float32x4_rcp_nr(clipminfx4(f32x4_dup(kMinDecay), decay)));
+        const float32x4_t r = ExpNegX4(k);
+
+        f32x4_str(&mCos[first], float32x4_mul(r, c));
+        f32x4_str(&mSin[first], float32x4_mul(r, s));
+        f32x4_str(&mGain[first], float32x4_sel(audible, gain, f32x4_dup(0.f)));
+    }
+
+    // scales the frequencies of all modes, keeping decays and gains
+    void Retune(float ratio)
+    {
+        for (int m = 0; m < N; m += 4)
+            SetModesX4(m, float32x4_mulscal(f32x4_ld(&mW0[m]), ratio), f32x4_ld(&mDecay[m]), f32x4_ld(&mModeGain[m]));
+    }
+
+    // adds an impulse of the given amplitude to every mode
+    void Excite(float amp)
+    {
+        for (int m = 0; m < N; m++)
+            mRe[m] += amp;
+        for (int g = 0; g < kGroups; g++)
+            mActive[g] = true;
+    }
+
+    // any mode still ringing
+    bool IsActive() const
+    {
+        for (int g = 0; g < kGroups; g++)
+            if (mActive[g])
+                return true;
+        return false;
+    }
+
+    /*===========================================================================*/
+    /* Rendering. */
+    /*===========================================================================*/
+
+    // in may be nullptr when there is no excitation, writes the sum of all modes to out[0..frames)
+    void Process(const float * in, float * out, size_t frames)
+    {
+        bool excited = false;
+        if (in != nullptr)
+        {
+            for (size_t i = 0; i < frames; i++)
+                excited = excited || (in[i] != 0.f);
+        }
+        if (excited)
+        {
+            for (int g = 0; g < kGroups; g++)
+                mActive[g] = true;
+        }
+
+        for (size_t i0 = 0; i0 < frames; i0 += kChunk)
+        {
+            const size_t n = (frames - i0 < kChunk) ? frames - i0 : kChunk;
+            float32x4_t acc[kChunk];
+            for (size_t i = 0; i < n; i++)
+                acc[i] = f32x4_dup(0.f);
+
+            for (int g = 0; g < kGroups; g++)
+            {
+                if (!mActive[g])
+                    continue;
+                const int m = g * 4;
+                float32x4_t re = f32x4_ld(&mRe[m]);
+                float32x4_t im = f32x4_ld(&mIm[m]);
+                const float32x4_t c = f32x4_ld(&mCos[m]);
+                const float32x4_t s = f32x4_ld(&mSin[m]);
+                const float32x4_t gain = f32x4_ld(&mGain[m]);
+
+                if (excited)
+                {
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        const float32x4_t x = f32x4_dup(in[i0 + i]);
+                        const float32x4_t ren = float32x4_add(float32x4_sub(float32x4_mul(re, c), float32x4_mul(im, s)), x);
+                        im = float32x4_add(float32x4_mul(im, c), float32x4_mul(re, s));
+                        re = ren;
+                        acc[i] = float32x4_fmuladd(acc[i], gain, im);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        const float32x4_t ren = float32x4_sub(float32x4_mul(re, c), float32x4_mul(im, s));
+                        im = float32x4_add(float32x4_mul(im, c), float32x4_mul(re, s));
+                        re = ren;
+                        acc[i] = float32x4_fmuladd(acc[i], gain, im);
+                    }
+                }
+
+                f32x4_str(&mRe[m], re);
+                f32x4_str(&mIm[m], im);
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                const float32x2_t h = vadd_f32(vget_low_f32(acc[i]), vget_high_f32(acc[i]));
+                out[i0 + i] = vget_lane_f32(h, 0) + vget_lane_f32(h, 1);
+            }
+        }
+
+        // retire groups that have rung out, clearing them also keeps denormals away
+        for (int g = 0; g < kGroups; g++)
+        {
+            if (!mActive[g])
+                continue;
+            const int m = g * 4;
+            const float32x4_t re = f32x4_ld(&mRe[m]);
+            const float32x4_t im = f32x4_ld(&mIm[m]);
+            const float32x4_t gain = f32x4_ld(&mGain[m]);
+            const float32x4_t energy = float32x4_mul(float32x4_add(float32x4_mul(re, re), float32x4_mul(im, im)), float32x4_mul(gain, gain));
+            if (!uint32x4_any(float32x4_gt(energy, f32x4_dup(kSilence))))
+            {
+                f32x4_str(&mRe[m], f32x4_dup(0.f));
+                f32x4_str(&mIm[m], f32x4_dup(0.f));
+                mActive[g] = false;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kChunk = 16;
+
+    // e^-k for k in [0, 0.44], 6th order Taylor series, relative error below 1e-6
+    static fast_inline float32x4_t ExpNegX4(float32x4_t k)
+    {
+        float32x4_t p = float32x4_fmulscaladd(f32x4_dup(1.f), k, -1.f / 6.f);
+        p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(k, p), -1.f / 5.f);
+        p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(k, p), -1.f / 4.f);
+        p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(k, p), -1.f / 3.f);
+        p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(k, p), -1.f / 2.f);
+        return float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(k, p), -1.f);
+    }
+
+    float mRe[N];
+    float mIm[N];
+    float mCos[N];
+    float mSin[N];
+    float mGain[N];
+    float mW0[N];
+    float mDecay[N];
+    float mModeGain[N];  // as set, mGain is muted above kMaxW0
+    bool mActive[kGroups];
+};
+
+}
+/** @} */
@@ -0,0 +1,135 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    NeutralState.h
+ * @brief   Tracks when an effect's settings leave the signal unchanged so processing can be pruned.
+ *
+ * The unit evaluates once per block whether its parameters, including their
+ * smoothers, have converged to a no-op configuration (fully dry mix, all EQ
+ * gains at 0 dB...) and passes the result to Update(). While IsBypassed() the
+ * unit runs a cheap path instead of its full processing. When a parameter moves
+ * again, IsWaking() is true for one block so that state which went stale while
+ * bypassed can be reset, and the full path is faded in from the cheap path over
+ * the fade length using ProcessFade().
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp
+{
+
+class NeutralState
+{
+public:
+    NeutralState():
+    mBypassed(false),
+    mWaking(false),
+    mFade(1.f),
+    mFadeIncrement(1.f / 64)
+    {
+    }
+
+    void Reset()
+    {
+        mBypassed = false;
+        mWaking = false;
+        mFade = 1.f;
+    }
+
+    // Length of the crossfade from the cheap path back to full processing
+    void SetFadeLength(uint32_t frames)
+    {
+        mFadeIncrement = 1.f / frames;
+    }
+
+    // Call once per block, before processing
+    void Update(bool neutral)
+    {
+        mWaking = false;
+
+        if (neutral)
+        {
+            // output of both paths is identical, no need to fade
+            mBypassed = true;
+            mFade = 1.f;
+            return;
+        }
+
+        if (mBypassed)
+        {
+            mBypassed = false;
+            mWaking = true;
+            mFade = 0.f;
+        }
+    }
+
+    bool IsBypassed() const
+    {
+        return mBypassed;
+    }
+
+    // First block after leaving the neutral state
+    bool IsWaking() const
+    {
+        return mWaking;
+    }
+
+    bool IsFading() const
+    {
+        return mFade < 1.f;
+    }
+
+    // Weight of the full processing path, call once per frame while fading
+    float ProcessFade()
+    {
+        const float fade = mFade + mFadeIncrement;
+        mFade = (fade < 1.f) ? fade : 1.f;
+        return mFade;
+    }
+
+private:
+    bool mBypassed;
+    bool mWaking;
+    float mFade;
+    float mFadeIncrement;
+};
+
+}
+/** @} */
@@ -0,0 +1,330 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    NoiseBlock.h
+ * @brief   Four lane white, pink and velvet noise generators with block output.
+ *
+ * Each instance owns four independent generator lanes, one per voice of a
+ * float32x4_t group, and carries its own seed so that several units or voices
+ * do not produce correlated noise. Lanes use the same xor/add generator as the
+ * Vox oscillator, https://www.musicdsp.org/en/latest/Synthesis/216-fast-whitenoise-generator.html
+ *
+ * The Fill*() methods write frames * kLanes samples, lane interleaved. White
+ * lanes are independent, so a white block can also be read as a single stream
+ * of frames * kLanes samples.
+ *
+ * The vector methods are built on NEON for the Cortex-A7 targets. Without NEON,
+ * e.g. on the Cortex-M nts units, the lanes are plain loops over kLanes and only
+ * the scalar and block methods are available.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "attributes.h"
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#include "utils/float_simd.h"
+#include "utils/int_simd.h"
+#endif
+
+namespace dsp
+{
+
+class NoiseBlock
+{
+public:
+    enum {
+        kLanes = 4
+    };
+
+    NoiseBlock()
+    {
+        Seed(0);
+        SetVelvetPeriod(kDefaultVelvetPeriod);
+    }
+
+    // Different seeds give uncorrelated lanes. Filter state is cleared.
+    void Seed(uint32_t seed)
+    {
+#if defined(__ARM_NEON)
+        int32_t x1[kLanes];
+        int32_t x2[kLanes];
+        for (int i = 0; i < kLanes; i++)
+        {
+            x1[i] = static_cast<int32_t>(Hash(seed + 2 * i));
+            x2[i] = static_cast<int32_t>(Hash(seed + 2 * i + 1));
+        }
+        mX1 = s32x4_ld(x1);
+        mX2 = s32x4_ld(x2);
+        mIndex = kLanes;
+        mPink0 = mPink1 = mPink2 = f32x4_dup(0.f);
+        mVelvetCount = u32x4_dup(0);
+        mVelvetPos = u32x4_dup(0);
+        mVelvetSign = f32x4_dup(0.f);
+#else
+        for (int i = 0; i < kLanes; i++)
+        {
+            mX1[i] = static_cast<int32_t>(Hash(seed + 2 * i));
+            mX2[i] = static_cast<int32_t>(Hash(seed + 2 * i + 1));
+            mPink0[i] = mPink1[i] = mPink2[i] = 0.f;
+            mVelvetCount[i] = 0;
+            mVelvetPos[i] = 0;
+            mVelvetSign[i] = 0.f;
+        }
+        mIndex = 0;
+#endif
+    }
+
+    // Average distance between velvet impulses in samples, at least 1
+    void SetVelvetPeriod(uint32_t period)
+    {
+        mVelvetPeriod = (period > 0) ? period : 1;
+    }
+
+    // Impulses per second
+    void SetVelvetDensity(float density, float samplerate)
+    {
+        SetVelvetPeriod((density > 0.f) ? static_cast<uint32_t>(samplerate / density) : 0xFFFFFFFF);
+    }
+
+#if defined(__ARM_NEON)
+    /*===========================================================================*/
+    /* Vector, one sample per lane. */
+    /*===========================================================================*/
+
+    // Uniform in [-1, 1]
+    fast_inline float32x4_t WhiteX4()
+    {
+        return si_i32x4qn_to_f32x4(NextX4(), 31);
+    }
+
+    // Paul Kellet's economy pink filter, -3 dB/octave above ~10 Hz, same RMS as WhiteX4()
+    fast_inline float32x4_t PinkX4()
+    {
+        const float32x4_t w = WhiteX4();
+        mPink0 = float32x4_fmulscaladd(float32x4_mulscal(mPink0, 0.99765f), w, 0.0990460f);
+        mPink1 = float32x4_fmulscaladd(float32x4_mulscal(mPink1, 0.96300f), w, 0.2965164f);
+        mPink2 = float32x4_fmulscaladd(float32x4_mulscal(mPink2, 0.57000f), w, 1.0526913f);
+        const float32x4_t pink = float32x4_fmulscaladd(float32x4_add(float32x4_add(mPink0, mPink1), mPink2), w, 0.1848f);
+        return float32x4_mulscal(pink, kPinkGain);
+    }
+
+    // One impulse of random sign at a random position in each period, zero elsewhere
+    fast_inline float32x4_t VelvetX4()
+    {
+        const int32x4_t r = NextX4();
+        const uint32x4_t hit = uint32x4_eq(mVelvetCount, mVelvetPos);
+        const float32x4_t out = float32x4_sel(hit, mVelvetSign, f32x4_dup(0.f));
+
+        mVelvetCount = uint32x4_add(mVelvetCount, u32x4_dup(1));
+        const uint32x4_t wrap = uint32x4_gte(mVelvetCount, u32x4_dup(mVelvetPeriod));
+
+        // sign from the top bit, position from the remaining 31 bits
+        const float32x4_t u = si_i32x4qn_to_f32x4(vandq_s32(r, vdupq_n_s32(0x7FFFFFFF)), 31);
+        const uint32x4_t pos = uint32x4_min(si_f32x4_to_u32x4(float32x4_mulscal(u, static_cast<float>(mVelvetPeriod))), u32x4_dup(mVelvetPeriod - 1));
+        const float32x4_t sign = float32x4_sel(int32x4_ltz(r), f32x4_dup(-1.f), f32x4_dup(1.f));
+
+        mVelvetCount = uint32x4_sel(wrap, u32x4_dup(0), mVelvetCount);
+        mVelvetPos = uint32x4_sel(wrap, pos, mVelvetPos);
+        mVelvetSign = float32x4_sel(wrap, sign, mVelvetSign);
+        return out;
+    }
+
+    /*===========================================================================*/
+    /* Scalar. */
+    /*===========================================================================*/
+
+    // Uniform in [-1, 1], drawn from the lanes in turn
+    fast_inline float White()
+    {
+        if (mIndex >= kLanes)
+        {
+            f32x4_str(mWhite, WhiteX4());
+            mIndex = 0;
+        }
+        return mWhite[mIndex++];
+    }
+
+    /*===========================================================================*/
+    /* Block. */
+    /*===========================================================================*/
+
+    // out must hold frames * kLanes samples
+    void FillWhite(float * out, size_t frames)
+    {
+        for (size_t i = 0; i < frames; i++)
+            f32x4_str(&out[i * kLanes], WhiteX4());
+    }
+
+    void FillPink(float * out, size_t frames)
+    {
+        for (size_t i = 0; i < frames; i++)
+            f32x4_str(&out[i * kLanes], PinkX4());
+    }
+
+    void FillVelvet(float * out, size_t frames)
+    {
+        for (size_t i = 0; i < frames; i++)
+            f32x4_str(&out[i * kLanes], VelvetX4());
+    }
+
+#else
+
+    /*===========================================================================*/
+    /* Scalar. */
+    /*===========================================================================*/
+
+    // Uniform in [-1, 1], drawn from the lanes in turn
+    fast_inline float White()
+    {
+        const float w = static_cast<float>(Next(mIndex)) * kQ31ToF32;
+        mIndex = (mIndex + 1) & (kLanes - 1);
+        return w;
+    }
+
+    /*===========================================================================*/
+    /* Block. */
+    /*===========================================================================*/
+
+    // out must hold frames * kLanes samples
+    void FillWhite(float * out, size_t frames)
+    {
+        for (size_t n = 0; n < frames; n++, out += kLanes)
+            for (int i = 0; i < kLanes; i++)
+                out[i] = static_cast<float>(Next(i)) * kQ31ToF32;
+    }
+
+    // Paul Kellet's economy pink filter, -3 dB/octave above ~10 Hz, same RMS as FillWhite()
+    void FillPink(float * out, size_t frames)
+    {
+        for (size_t n = 0; n < frames; n++, out += kLanes)
+        {
+            for (int i = 0; i < kLanes; i++)
+            {
+                const float w = static_cast<float>(Next(i)) * kQ31ToF32;
+                mPink0[i] = 0.99765f * mPink0[i] + 0.0990460f * w;
+                mPink1[i] = 0.96300f * mPink1[i] + 0.2965164f * w;
+                mPink2[i] = 0.57000f * mPink2[i] + 1.0526913f * w;
+                out[i] = (mPink0[i] + mPink1[i] + mPink2[i] + 0.1848f * w) * kPinkGain;
+            }
+        }
+    }
+
+    // One impulse of random sign at a random position in each period, zero elsewhere
+    void FillVelvet(float * out, size_t frames)
+    {
+        for (size_t n = 0; n < frames; n++, out += kLanes)
+        {
+            for (int i = 0; i < kLanes; i++)
+            {
+                const int32_t r = Next(i);
+                out[i] = (mVelvetCount[i] == mVelvetPos[i]) ? mVelvetSign[i] : 0.f;
+                if (++mVelvetCount[i] >= mVelvetPeriod)
+                {
+                    // sign from the top bit, position from the remaining 31 bits
+                    const uint64_t u = static_cast<uint32_t>(r) & 0x7FFFFFFF;
+                    mVelvetCount[i] = 0;
+                    mVelvetPos[i] = static_cast<uint32_t>((u * mVelvetPeriod) >> 31);
+                    mVelvetSign[i] = (r < 0) ? -1.f : 1.f;
+                }
+            }
+        }
+    }
+
+#endif
+
+private:
+    static const uint32_t kDefaultVelvetPeriod = 24; // 2000 impulses/s @ 48 kHz
+    static constexpr float kPinkGain = 0.3372f;
+
+    // lowbias32 integer hash, spreads consecutive seeds over the whole state space
+    static uint32_t Hash(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7FEB352D;
+        x ^= x >> 15;
+        x *= 0x846CA68B;
+        x ^= x >> 16;
+        return (x != 0) ? x : 0x9E3779B9;
+    }
+
+#if defined(__ARM_NEON)
+    fast_inline int32x4_t NextX4()
+    {
+        mX1 = veorq_s32(mX1, mX2);
+        mX2 = int32x4_add(mX2, mX1);
+        return mX2;
+    }
+
+    int32x4_t mX1;
+    int32x4_t mX2;
+    float32x4_t mPink0;
+    float32x4_t mPink1;
+    float32x4_t mPink2;
+    uint32x4_t mVelvetCount;
+    uint32x4_t mVelvetPos;
+    float32x4_t mVelvetSign;
+    uint32_t mVelvetPeriod;
+    uint32_t mIndex;
+    float mWhite[kLanes];
+#else
+    static constexpr float kQ31ToF32 = 1.f / 2147483648.f;
+
+    fast_inline int32_t Next(int i)
+    {
+        mX1[i] ^= mX2[i];
+        mX2[i] = static_cast<int32_t>(static_cast<uint32_t>(mX2[i]) + static_cast<uint32_t>(mX1[i]));
+        return mX2[i];
+    }
+
+    int32_t mX1[kLanes];
+    int32_t mX2[kLanes];
+    float mPink0[kLanes];
+    float mPink1[kLanes];
+    float mPink2[kLanes];
+    uint32_t mVelvetCount[kLanes];
+    uint32_t mVelvetPos[kLanes];
+    float mVelvetSign[kLanes];
+    uint32_t mVelvetPeriod;
+    uint32_t mIndex;
+#endif
+};
+
+}
+/** @} */
@@ -0,0 +1,370 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    Oversampler.h
+ * @brief   2x/4x/8x oversampling built from polyphase IIR halfband stages.
+ *
+ * Meant to wrap a single nonlinearity rather than a whole voice: upsample one
+ * sample, run the shaper Factor times, filter and decimate back. Each 2x stage
+ * is a pair of allpass chains running at the lower rate (Laurent de Soras' hiir
+ * structure), so the cost per stage is one multiply per coefficient and sample.
+ *
+ * Like ParallelBiQuad, state is kept per lane so that each voice owns a lane,
+ * and the x1/x4 methods take the index of the first lane they work on.
+ * Up and down filters have separate state.
+ *
+ * The preset sets the first stage, which carries the steep transition band.
+ * Further stages only have to reject images far above the base band and use a
+ * short fixed chain.
+ *
+ *   Preset        | Stopband | Passband   | Latency (base rate samples)
+ *   kLowLatency   | -70 dB   | 0.40 * fs  | ~1.8
+ *   kBalanced     | -80 dB   | 0.45 * fs  | ~2.4
+ *   kHighQuality  | -99 dB   | 0.46 * fs  | ~3.1
+ *
+ * Latency is the group delay of the up/down pair at DC, with 0.5 samples added
+ * at 4x and 0.8 samples at 8x. Higher in the passband, as with any IIR halfband.
+ *
+ * The single lane methods are plain C++. The four lane and block methods need
+ * NEON and are only available on the Cortex-A7 targets, the Cortex-M nts units
+ * use the single lane methods with NumLanes = 1.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "attributes.h"
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#include "utils/float_simd.h"
+#endif
+
+namespace dsp
+{
+
+template <int Factor, int NumLanes = 4>
+class Oversampler
+{
+public:
+    static_assert(Factor == 2 || Factor == 4 || Factor == 8, "Factor must be 2, 4 or 8");
+#if defined(__ARM_NEON)
+    static_assert(NumLanes % 4 == 0, "NumLanes must be a multiple of 4");
+#else
+    static_assert(NumLanes > 0, "NumLanes must be at least 1");
+#endif
+
+    enum Preset {
+        kLowLatency = 0,
+        kBalanced,
+        kHighQuality,
+        kNumPresets
+    };
+
+    enum {
+        kNumStages = (Factor == 2) ? 1 : (Factor == 4) ? 2 : 3,
+        kMaxCoeffs = 8
+    };
+
+    Oversampler()
+    {
+        SetPreset(kBalanced);
+    }
+
+    // Clears the filter state
+    void SetPreset(Preset preset)
+    {
+        const int p = (preset < kNumPresets) ? preset : kBalanced;
+        mPreset = static_cast<Preset>(p);
+        for (int s = 0; s < kNumStages; s++)
+        {
+            const float * coeffs = (s == 0) ? kPresetCoeffs[p] : kUpperStageCoeffs;
+            mNumCoeffs[s] = (s == 0) ? kPresetNumCoeffs[p] : kUpperStageNumCoeffs;
+            for (int c = 0; c < kMaxCoeffs; c++)
+                mCoeffs[s][c] = (c < mNumCoeffs[s]) ? coeffs[c] : 0.f;
+        }
+        Reset();
+    }
+
+    Preset GetPreset() const
+    {
+        return mPreset;
+    }
+
+    // Round trip delay at DC in base rate samples
+    float GetLatency() const
+    {
+        return kPresetLatency[mPreset] + kUpperStageLatency[kNumStages - 1];
+    }
+
+    void Reset()
+    {
+        for (int s = 0; s < kNumStages; s++)
+        {
+            for (int c = 0; c < kMaxCoeffs; c++)
+            {
+                for (int l = 0; l < NumLanes; l++)
+                {
+                    mUpX[s][c][l] = mUpY[s][c][l] = 0.f;
+                    mDownX[s][c][l] = mDownY[s][c][l] = 0.f;
+                }
+            }
+        }
+    }
+
+    /*===========================================================================*/
+    /* Single lane. */
+    /*===========================================================================*/
+
+    // out must hold Factor samples
+    fast_inline void UpX1(const float x, float * out, int lane = 0)
+    {
+        float tmp[Factor];
+        float * src = (kNumStages & 1) ? tmp : out;
+        float * dst = (kNumStages & 1) ? out : tmp;
+        src[0] = x;
+        for (int s = 0, n = 1; s < kNumStages; s++, n <<= 1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                float even = src[i];
+                float odd = src[i];
+                AllpassPairX1(mUpX[s], mUpY[s], s, even, odd, lane);
+                dst[2 * i] = even;
+                dst[2 * i + 1] = odd;
+            }
+            float * t = src; src = dst; dst = t;
+        }
+    }
+
+    // in holds Factor samples, in time order
+    fast_inline float DownX1(const float * in, int lane = 0)
+    {
+        float tmp[Factor];
+        for (int i = 0; i < Factor; i++)
+            tmp[i] = in[i];
+        for (int s = kNumStages - 1, n = Factor >> 1; s >= 0; s--, n >>= 1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                float even = tmp[2 * i + 1];
+                float odd = tmp[2 * i];
+                AllpassPairX1(mDownX[s], mDownY[s], s, even, odd, lane);
+                tmp[i] = 0.5f * (even + odd);
+            }
+        }
+        return tmp[0];
+    }
+
+    // Runs shaper at the oversampled rate, float shaper(float)
+    template <typename Shaper>
+    fast_inline float ProcessX1(const float x, Shaper shaper, int lane = 0)
+    {
+        float buf[Factor];
+        UpX1(x, buf, lane);
+        for (int i = 0; i < Factor; i++)
+            buf[i] = shaper(buf[i]);
+        return DownX1(buf, lane);
+    }
+
+#if defined(__ARM_NEON)
+    /*===========================================================================*/
+    /* Four lanes. */
+    /*===========================================================================*/
+
+    fast_inline void UpX4(const float32x4_t x, float32x4_t * out, int lane = 0)
+    {
+        float32x4_t tmp[Factor];
+        float32x4_t * src = (kNumStages & 1) ? tmp : out;
+        float32x4_t * dst = (kNumStages & 1) ? out : tmp;
+        src[0] = x;
+        for (int s = 0, n = 1; s < kNumStages; s++, n <<= 1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                float32x4_t even = src[i];
+                float32x4_t odd = src[i];
+                AllpassPairX4(mUpX[s], mUpY[s], s, even, odd, lane);
+                dst[2 * i] = even;
+                dst[2 * i + 1] = odd;
+            }
+            float32x4_t * t = src; src = dst; dst = t;
+        }
+    }
+
+    fast_inline float32x4_t DownX4(const float32x4_t * in, int lane = 0)
+    {
+        float32x4_t tmp[Factor];
+        for (int i = 0; i < Factor; i++)
+            tmp[i] = in[i];
+        for (int s = kNumStages - 1, n = Factor >> 1; s >= 0; s--, n >>= 1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                float32x4_t even = tmp[2 * i + 1];
+                float32x4_t odd = tmp[2 * i];
+                AllpassPairX4(mDownX[s], mDownY[s], s, even, odd, lane);
+                tmp[i] = float32x4_mulscal(float32x4_add(even, odd), 0.5f);
+            }
+        }
+        return tmp[0];
+    }
+
+    // Runs shaper at the oversampled rate, float32x4_t shaper(float32x4_t)
+    template <typename Shaper>
+    fast_inline float32x4_t ProcessX4(const float32x4_t x, Shaper shaper, int lane = 0)
+    {
+        float32x4_t buf[Factor];
+        UpX4(x, buf, lane);
+        for (int i = 0; i < Factor; i++)
+            buf[i] = shaper(buf[i]);
+        return DownX4(buf, lane);
+    }
+
+    /*===========================================================================*/
+    /* Block, NumLanes interleaved samples per frame. */
+    /*===========================================================================*/
+
+    // out must hold frames * Factor * NumLanes samples
+    void Upsample(const float * in, float * out, size_t frames)
+    {
+        float32x4_t buf[Factor];
+        for (size_t f = 0; f < frames; f++)
+        {
+            for (int l = 0; l < NumLanes; l += 4)
+            {
+                UpX4(f32x4_ld(&in[f * NumLanes + l]), buf, l);
+                for (int i = 0; i < Factor; i++)
+                    f32x4_str(&out[(f * Factor + i) * NumLanes + l], buf[i]);
+            }
+        }
+    }
+
+    // in holds frames * Factor * NumLanes samples
+    void Downsample(const float * in, float * out, size_t frames)
+    {
+        float32x4_t buf[Factor];
+        for (size_t f = 0; f < frames; f++)
+        {
+            for (int l = 0; l < NumLanes; l += 4)
+            {
+                for (int i = 0; i < Factor; i++)
+                    buf[i] = f32x4_ld(&in[(f * Factor + i) * NumLanes + l]);
+                f32x4_str(&out[f * NumLanes + l], DownX4(buf, l));
+            }
+        }
+    }
+#endif
+
+private:
+    // first order allpass sections, y = a * (x - y1) + x1, alternating between both paths
+    fast_inline void AllpassPairX1(float (*x1)[NumLanes], float (*y1)[NumLanes], int stage, float & even, float & odd, int lane)
+    {
+        const float * a = mCoeffs[stage];
+        for (int c = 0; c < mNumCoeffs[stage]; c += 2)
+        {
+            const float e = (even - y1[c][lane]) * a[c] + x1[c][lane];
+            x1[c][lane] = even;
+            y1[c][lane] = e;
+            even = e;
+
+            const float o = (odd - y1[c + 1][lane]) * a[c + 1] + x1[c + 1][lane];
+            x1[c + 1][lane] = odd;
+            y1[c + 1][lane] = o;
+            odd = o;
+        }
+    }
+
+#if defined(__ARM_NEON)
+    fast_inline void AllpassPairX4(float (*x1)[NumLanes], float (*y1)[NumLanes], int stage, float32x4_t & even, float32x4_t & odd, int lane)
+    {
+        const float * a = mCoeffs[stage];
+        for (int c = 0; c < mNumCoeffs[stage]; c += 2)
+        {
+            const float32x4_t e = float32x4_fmulscaladd(f32x4_ld(&x1[c][lane]), float32x4_sub(even, f32x4_ld(&y1[c][lane])), a[c]);
+            f32x4_str(&x1[c][lane], even);
+            f32x4_str(&y1[c][lane], e);
+            even = e;
+
+            const float32x4_t o = float32x4_fmulscaladd(f32x4_ld(&x1[c + 1][lane]), float32x4_sub(odd, f32x4_ld(&y1[c + 1][lane])), a[c + 1]);
+            f32x4_str(&x1[c + 1][lane], odd);
+            f32x4_str(&y1[c + 1][lane], o);
+            odd = o;
+        }
+    }
+#endif
+
+    // Coefficients from hiir's elliptic halfband design (number of coefficients, transition bandwidth)
+    static constexpr int kPresetNumCoeffs[kNumPresets] = {4, 6, 8};
+    static constexpr float kPresetCoeffs[kNumPresets][kMaxCoeffs] = {
+        // 4, 0.1
+        {0.079866426f, 0.283829345f, 0.545323651f, 0.834411891f},
+        // 6, 0.05
+        {0.060297391f, 0.215971445f, 0.412590720f, 0.604358626f, 0.772715654f, 0.923886139f},
+        // 8, 0.04
+        {0.040633461f, 0.150505129f, 0.300757056f, 0.460774505f, 0.609524315f, 0.738503841f, 0.849223810f, 0.949742784f}
+    };
+    static constexpr float kPresetLatency[kNumPresets] = {1.79f, 2.36f, 3.07f};
+
+    // 2, 0.255, -63 dB
+    static constexpr int kUpperStageNumCoeffs = 2;
+    static constexpr float kUpperStageCoeffs[kMaxCoeffs] = {0.136456865f, 0.582147997f};
+    // indexed by number of stages - 1
+    static constexpr float kUpperStageLatency[3] = {0.f, 0.52f, 0.77f};
+
+    float mCoeffs[kNumStages][kMaxCoeffs];
+    int mNumCoeffs[kNumStages];
+    float mUpX[kNumStages][kMaxCoeffs][NumLanes];
+    float mUpY[kNumStages][kMaxCoeffs][NumLanes];
+    float mDownX[kNumStages][kMaxCoeffs][NumLanes];
+    float mDownY[kNumStages][kMaxCoeffs][NumLanes];
+    Preset mPreset;
+};
+
+template <int Factor, int NumLanes>
+constexpr int Oversampler<Factor, NumLanes>::kPresetNumCoeffs[];
+template <int Factor, int NumLanes>
+constexpr float Oversampler<Factor, NumLanes>::kPresetCoeffs[][Oversampler<Factor, NumLanes>::kMaxCoeffs];
+template <int Factor, int NumLanes>
+constexpr float Oversampler<Factor, NumLanes>::kPresetLatency[];
+template <int Factor, int NumLanes>
+constexpr float Oversampler<Factor, NumLanes>::kUpperStageCoeffs[];
+template <int Factor, int NumLanes>
+constexpr float Oversampler<Factor, NumLanes>::kUpperStageLatency[];
+
+}
+/** @} */
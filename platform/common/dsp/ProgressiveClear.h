@@ -0,0 +1,189 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    ProgressiveClear.h
+ * @brief   Clears a circular delay line over several render callbacks.
+ *
+ * Clearing a whole delfx/revfx buffer in Reset() or Resume() costs up to 1 MB
+ * of stores in a single block. Instead, start a progressive clear and call
+ * Process() once per render callback: a chunk of memory is zeroed each time,
+ * starting right behind the oldest sample the line would read and moving away
+ * from the write head, so memory written since the clear started is never
+ * touched.
+ *
+ * Until clearing completes, reads further back than GetReadLimit() may hit
+ * stale memory. Clamping tap positions to the read limit masks them: every
+ * position from the limit onwards reads cleared memory, i.e. silence.
+ *
+ * Assumes the dsp::DelayLine convention of a decrementing write index with
+ * taps read at (write index + delay).
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dsp
+{
+
+class ProgressiveClear
+{
+public:
+    enum {
+        kDefaultChunkBytes = 0x2000 // 8 KB per callback
+    };
+
+    ProgressiveClear():
+    mLine(nullptr),
+    mSize(0),
+    mElementBytes(0),
+    mChunk(0),
+    mFirst(0),
+    mWritten(0),
+    mCleared(0),
+    mReadLimit(0),
+    mActive(false)
+    {
+    }
+
+    // memory:       circular buffer of size elements, size must be a power of two
+    // elementBytes: bytes per element, e.g. 8 for a line of 4 interleaved int16
+    // writeIndex:   index (already masked) the next sample will be written to
+    void Start(void * memory, uint32_t size, uint32_t elementBytes, uint32_t writeIndex,
+               uint32_t chunkBytes = kDefaultChunkBytes)
+    {
+        mLine = static_cast<uint8_t *>(memory);
+        mSize = size;
+        mElementBytes = elementBytes;
+        mChunk = chunkBytes / elementBytes;
+        mFirst = (writeIndex + 1) & (size - 1);
+        mWritten = 0;
+        mCleared = 0;
+        mReadLimit = 0;
+        mActive = (memory != nullptr) && (size > 0);
+    }
+
+    // Stop clearing, memory is considered valid as is
+    void Cancel()
+    {
+        mActive = false;
+    }
+
+    // Call once per render callback, before the line is written.
+    // frames is the number of samples that will be written during the callback.
+    void Process(uint32_t frames)
+    {
+        if (!mActive)
+            return;
+
+        // writes have caught up with the cleared region, nothing stale is left
+        if (mCleared + mWritten >= mSize)
+        {
+            mActive = false;
+            return;
+        }
+
+        // never clear anything that was written since Start()
+        const uint32_t remaining = mSize - mCleared - mWritten;
+
+        // the silent read position must stay inside the cleared region for the whole block
+        const uint32_t chunk = (mChunk > frames + 2) ? mChunk : frames + 2;
+
+        if (chunk >= remaining)
+        {
+            ClearRange(mCleared, remaining);
+            mActive = false;
+            return;
+        }
+
+        ClearRange(mCleared, chunk);
+        mCleared += chunk;
+
+        mReadLimit = mWritten + mCleared - 2;
+        mWritten += frames;
+    }
+
+    bool IsActive() const
+    {
+        return mActive;
+    }
+
+    // Taps at or beyond this delay read silence until the next Process() call.
+    // Interpolated reads may access one sample past the limit.
+    uint32_t GetReadLimit() const
+    {
+        return mActive ? mReadLimit : (mSize - 1);
+    }
+
+    uint32_t MaskDelay(uint32_t delay) const
+    {
+        const uint32_t limit = GetReadLimit();
+        return (delay < limit) ? delay : limit;
+    }
+
+    float MaskDelay(float delay) const
+    {
+        const float limit = GetReadLimit();
+        return (delay < limit) ? delay : limit;
+    }
+
+private:
+    // offset and count in elements, relative to the first element to clear
+    void ClearRange(uint32_t offset, uint32_t count)
+    {
+        const uint32_t start = (mFirst + offset) & (mSize - 1);
+        const uint32_t head = (start + count > mSize) ? (mSize - start) : count;
+        memset(mLine + start * mElementBytes, 0, head * mElementBytes);
+        if (head < count)
+            memset(mLine, 0, (count - head) * mElementBytes);
+    }
+
+    uint8_t * mLine;
+    uint32_t mSize;
+    uint32_t mElementBytes;
+    uint32_t mChunk;
+    uint32_t mFirst;
+    uint32_t mWritten;
+    uint32_t mCleared;
+    uint32_t mReadLimit;
+    bool mActive;
+};
+
+}
+/** @} */
@@ -0,0 +1,243 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    SdramArena.h
+ * @brief   Linear sub-allocator for the block returned by the sdram_alloc hook.
+ *
+ * Units get a single SDRAM block per instance. Instead of carving it by hand
+ * with pointer arithmetic, assign it to an arena once in Init() and request
+ * typed, aligned sub-buffers from it. Layout then lives in one place, and
+ * running out of memory is reported instead of silently overlapping buffers.
+ *
+ * Building with DEBUG defined writes a guard pattern after every allocation,
+ * which can be verified with CheckGuards(). Guards only occupy slack: the
+ * alignment padding before the next allocation or the unused end of the block.
+ * They never count against the space available to allocations, a guard simply
+ * retires when a later allocation claims its bytes, so debug and release
+ * builds lay out memory identically.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp
+{
+
+class SdramArena
+{
+public:
+    enum {
+        kAlignVector = 16,    // NEON q register load/store
+        kAlignCacheLine = 64  // L1 data cache line
+    };
+
+    SdramArena():
+    mBase(nullptr),
+    mSize(0),
+    mOffset(0),
+    mHighWater(0)
+#ifdef DEBUG
+    , mNumGuards(0)
+#endif
+    {
+    }
+
+    // memory must stay valid until SetMemory() is called again
+    void SetMemory(void * memory, size_t size)
+    {
+        mBase = static_cast<uint8_t *>(memory);
+        mSize = (memory != nullptr) ? size : 0;
+        mOffset = 0;
+        mHighWater = 0;
+#ifdef DEBUG
+        mNumGuards = 0;
+#endif
+    }
+
+    // Returns nullptr if the request does not fit in the remaining space.
+    // alignment must be a power of two
+    template <typename T>
+    T * Allocate(size_t count, size_t alignment = kAlignVector)
+    {
+        if (mBase == nullptr)
+            return nullptr;
+
+        const uintptr_t base = reinterpret_cast<uintptr_t>(mBase);
+        const uintptr_t mask = static_cast<uintptr_t>(alignment - 1);
+        const size_t start = ((base + mOffset + mask) & ~mask) - base;
+        const size_t bytes = count * sizeof(T);
+        const size_t end = start + bytes;
+
+        if (end < start || end > mSize)
+            return nullptr;
+
+#ifdef DEBUG
+        // retire guards lying in the new allocation, then guard it if slack remains after it
+        while (mNumGuards > 0 && mGuardOffsets[mNumGuards - 1] + kGuardSize > start)
+            mNumGuards--;
+        if (mNumGuards < kMaxGuards && end + kGuardSize <= mSize)
+        {
+            WriteGuard(end);
+            mGuardOffsets[mNumGuards++] = end;
+        }
+#endif
+
+        mOffset = end;
+        mHighWater = (mOffset > mHighWater) ? mOffset : mHighWater;
+
+        return reinterpret_cast<T *>(mBase + start);
+    }
+
+    // Current fill position, can be handed back to Rewind()
+    size_t GetMark() const
+    {
+        return mOffset;
+    }
+
+    // Release everything allocated after mark. Memory content is left untouched.
+    void Rewind(size_t mark)
+    {
+        mOffset = (mark < mOffset) ? mark : mOffset;
+#ifdef DEBUG
+        while (mNumGuards > 0 && mGuardOffsets[mNumGuards - 1] >= mOffset)
+            mNumGuards--;
+#endif
+    }
+
+    // Release all allocations, typically called before re-laying out buffers
+    void Reset()
+    {
+        Rewind(0);
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    size_t GetUsed() const
+    {
+        return mOffset;
+    }
+
+    size_t GetAvailable() const
+    {
+        return mSize - mOffset;
+    }
+
+    // Largest amount of memory in use since SetMemory(), useful to size BUFFER_LENGTH
+    size_t GetHighWaterMark() const
+    {
+        return mHighWater;
+    }
+
+    // Returns false if any live allocation wrote past its end.
+    // Always true when DEBUG is not defined.
+    bool CheckGuards() const
+    {
+#ifdef DEBUG
+        for (size_t i = 0; i < mNumGuards; i++)
+        {
+            const uint8_t * guard = mBase + mGuardOffsets[i];
+            for (size_t j = 0; j < kGuardSize; j++)
+            {
+                if (guard[j] != GuardByte(j))
+                    return false;
+            }
+        }
+#endif
+        return true;
+    }
+
+    // Rewinds the arena to where it was on construction when leaving the scope
+    class Scope
+    {
+    public:
+        explicit Scope(SdramArena & arena):
+        mArena(arena),
+        mMark(arena.GetMark())
+        {
+        }
+
+        ~Scope()
+        {
+            mArena.Rewind(mMark);
+        }
+
+    private:
+        Scope(const Scope &);
+        Scope & operator=(const Scope &);
+
+        SdramArena & mArena;
+        const size_t mMark;
+    };
+
+private:
+    uint8_t * mBase;
+    size_t mSize;
+    size_t mOffset;
+    size_t mHighWater;
+
+#ifdef DEBUG
+    enum {
+        kMaxGuards = 32,
+        kGuardSize = 16
+    };
+    static const uint32_t kGuardPattern = 0xDEADBEEF;
+
+    // guards are not necessarily 4 byte aligned when T is smaller than a word
+    static uint8_t GuardByte(size_t j)
+    {
+        return static_cast<uint8_t>(kGuardPattern >> ((j & 3) << 3));
+    }
+
+    void WriteGuard(size_t offset)
+    {
+        uint8_t * guard = mBase + offset;
+        for (size_t j = 0; j < kGuardSize; j++)
+            guard[j] = GuardByte(j);
+    }
+
+    size_t mGuardOffsets[kMaxGuards];
+    size_t mNumGuards;
+#endif
+};
+
+}
+/** @} */
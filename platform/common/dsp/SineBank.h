@@ -0,0 +1,297 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    SineBank.h
+ * @brief   Additive sine oscillator bank for one voice.
+ *
+ * Partials are recursive quadrature oscillators: each sample rotates the
+ * state (x, y) by the partial's angular frequency, and y is the sine output.
+ * Four partials share a float32x4_t, so a sample costs four multiplies and
+ * adds per group instead of a table lookup per partial like osc_sinf().
+ *
+ * Frequencies and amplitudes are targets reached over the next rendered block.
+ * Amplitudes ramp linearly. Frequencies glide by rotating the coefficients
+ * themselves, which keeps the oscillators at unit gain during the glide.
+ * Silent partials jump to their new frequency without a glide.
+ * Rounding drift is removed by renormalising the state once per block.
+ *
+ * Partials at or above kMaxW0 are faded out, and groups whose partials are
+ * all silent are skipped.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/float_simd_approx.h"
+#include "utils/int_simd.h"
+
+namespace dsp
+{
+
+template <int MaxPartials = 64>
+class SineBank
+{
+public:
+    static_assert(MaxPartials % 4 == 0, "MaxPartials must be a multiple of 4");
+
+    static constexpr int kGroups = MaxPartials / 4;
+    static constexpr float kMaxW0 = 0.48f; // partials are culled above this, cycles per sample
+
+    SineBank()
+    {
+        Reset();
+    }
+
+    // silences all partials and restarts them at phase 0
+    void Reset()
+    {
+        for (int p = 0; p < MaxPartials; p++)
+        {
+            mX[p] = 1.f;
+            mY[p] = 0.f;
+            mCos[p] = mCosTarget[p] = 1.f;
+            mSin[p] = mSinTarget[p] = 0.f;
+            mW0[p] = mW0Target[p] = 0.f;
+            mAmp[p] = mAmpTarget[p] = 0.f;
+        }
+    }
+
+    // w0 in cycles per sample
+    void SetPartial(int index, float w0, float amp)
+    {
+        const float a = 2.f * M_PI * clipminmaxf(0.f, w0, 0.5f);
+        float32x4_t c, s;
+        fastsincosfx4(f32x4_dup(a), &c, &s);
+        mW0Target[index] = a;
+        mCosTarget[index] = vgetq_lane_f32(c, 0);
+        mSinTarget[index] = vgetq_lane_f32(s, 0);
+        mAmpTarget[index] = (w0 < kMaxW0) ? amp : 0.f;
+    }
+
+    // sets partials first to first + 3, first must be a multiple of 4
+    fast_inline void SetPartialsX4(int first, float32x4_t w0, float32x4_t amp)
+    {
+        w0 = clipminmaxfx4(f32x4_dup(0.f), w0, f32x4_dup(0.5f));
+        const float32x4_t a = float32x4_mulscal(w0, 2.f * M_PI);
+        float32x4_t c, s;
+        fastsincosfx4(a, &c, &s);
+        f32x4_str(&mW0Target[first], a);
+        f32x4_str(&mCosTarget[first], c);
+        f32x4_str(&mSinTarget[first], s);
+        f32x4_str(&mAmpTarget[first], float32x4_sel(float32x4_lt(w0, f32x4_dup(kMaxW0)), amp, f32x4_dup(0.f)));
+    }
+
+    // partial k at (k + 1) * w0 with amplitude amps[k], the partials from count on are silenced
+    void SetHarmonics(float w0, const float * amps, int count)
+    {
+        count = (count < MaxPartials) ? count : MaxPartials;
+        const float32x4_t step = f32x4_dup(4.f * w0);
+        float32x4_t w = float32x4(w0, 2.f * w0, 3.f * w0, 4.f * w0);
+        for (int p = 0; p < MaxPartials; p += 4)
+        {
+            float a[4];
+            for (int k = 0; k < 4; k++)
+                a[k] = (p + k < count) ? amps[p + k] : 0.f;
+            SetPartialsX4(p, w, f32x4_ld(a));
+            w = float32x4_add(w, step);
+        }
+    }
+
+    // number of partials up to the last audible group
+    int GetActivePartials() const
+    {
+        for (int g = kGroups - 1; g >= 0; g--)
+            if (IsAudible(g))
+                return (g + 1) * 4;
+        return 0;
+    }
+
+    /*===========================================================================*/
+    /* Rendering. */
+    /*===========================================================================*/
+
+    // writes the sum of all partials to out[0..frames)
+    void Render(float * out, size_t frames)
+    {
+        if (frames == 0)
+            return;
+
+        const float invFrames = 1.f / frames;
+        int numGroups = 0;
+        for (int g = 0; g < kGroups; g++)
+        {
+            const int p = g * 4;
+            mActive[g] = IsAudible(g);
+            if (!mActive[g])
+                continue;
+            numGroups = g + 1;
+
+            f32x4_str(&mAmpStep[p], float32x4_mulscal(float32x4_sub(f32x4_ld(&mAmpTarget[p]), f32x4_ld(&mAmp[p])), invFrames));
+
+            // silent partials start at their new frequency instead of gliding there
+            const uint32x4_t silent = float32x4_eq(f32x4_ld(&mAmp[p]), f32x4_dup(0.f));
+            f32x4_str(&mW0[p], float32x4_sel(silent, f32x4_ld(&mW0Target[p]), f32x4_ld(&mW0[p])));
+            f32x4_str(&mCos[p], float32x4_sel(silent, f32x4_ld(&mCosTarget[p]), f32x4_ld(&mCos[p])));
+            f32x4_str(&mSin[p], float32x4_sel(silent, f32x4_ld(&mSinTarget[p]), f32x4_ld(&mSin[p])));
+
+            // per sample rotation of the coefficients for a linear frequency glide
+            const float32x4_t dw = float32x4_mulscal(float32x4_sub(f32x4_ld(&mW0Target[p]), f32x4_ld(&mW0[p])), invFrames);
+            mGliding[g] = uint32x4_any(float32x4_gt(si_fabsfx4(dw), f32x4_dup(0.f)));
+            if (mGliding[g])
+            {
+                float32x4_t c, s;
+                fastsincosfx4(dw, &c, &s);
+                f32x4_str(&mGlideCos[p], c);
+                f32x4_str(&mGlideSin[p], s);
+            }
+        }
+
+        for (size_t i0 = 0; i0 < frames; i0 += kChunk)
+        {
+            const size_t n = (frames - i0 < kChunk) ? frames - i0 : kChunk;
+            float32x4_t acc[kChunk];
+            for (size_t i = 0; i < n; i++)
+                acc[i] = f32x4_dup(0.f);
+
+            for (int g = 0; g < numGroups; g++)
+            {
+                if (!mActive[g])
+                    continue;
+                const int p = g * 4;
+                float32x4_t x = f32x4_ld(&mX[p]);
+                float32x4_t y = f32x4_ld(&mY[p]);
+                float32x4_t c = f32x4_ld(&mCos[p]);
+                float32x4_t s = f32x4_ld(&mSin[p]);
+                float32x4_t amp = f32x4_ld(&mAmp[p]);
+                const float32x4_t ampStep = f32x4_ld(&mAmpStep[p]);
+
+                if (mGliding[g])
+                {
+                    const float32x4_t gc = f32x4_ld(&mGlideCos[p]);
+                    const float32x4_t gs = f32x4_ld(&mGlideSin[p]);
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        const float32x4_t cn = float32x4_sub(float32x4_mul(c, gc), float32x4_mul(s, gs));
+                        s = float32x4_add(float32x4_mul(s, gc), float32x4_mul(c, gs));
+                        c = cn;
+                        const float32x4_t xn = float32x4_sub(float32x4_mul(x, c), float32x4_mul(y, s));
+                        y = float32x4_add(float32x4_mul(y, c), float32x4_mul(x, s));
+                        x = xn;
+                        amp = float32x4_add(amp, ampStep);
+                        acc[i] = float32x4_fmuladd(acc[i], amp, y);
+                    }
+                    f32x4_str(&mCos[p], c);
+                    f32x4_str(&mSin[p], s);
+                }
+                else
+                {
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        const float32x4_t xn = float32x4_sub(float32x4_mul(x, c), float32x4_mul(y, s));
+                        y = float32x4_add(float32x4_mul(y, c), float32x4_mul(x, s));
+                        x = xn;
+                        amp = float32x4_add(amp, ampStep);
+                        acc[i] = float32x4_fmuladd(acc[i], amp, y);
+                    }
+                }
+
+                f32x4_str(&mX[p], x);
+                f32x4_str(&mY[p], y);
+                f32x4_str(&mAmp[p], amp);
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                const float32x2_t h = vadd_f32(vget_low_f32(acc[i]), vget_high_f32(acc[i]));
+                out[i0 + i] = vget_lane_f32(h, 0) + vget_lane_f32(h, 1);
+            }
+        }
+
+        // land exactly on the targets and pull the state back to the unit circle
+        for (int g = 0; g < numGroups; g++)
+        {
+            if (!mActive[g])
+                continue;
+            const int p = g * 4;
+            f32x4_str(&mAmp[p], f32x4_ld(&mAmpTarget[p]));
+            f32x4_str(&mW0[p], f32x4_ld(&mW0Target[p]));
+            f32x4_str(&mCos[p], f32x4_ld(&mCosTarget[p]));
+            f32x4_str(&mSin[p], f32x4_ld(&mSinTarget[p]));
+
+            const float32x4_t x = f32x4_ld(&mX[p]);
+            const float32x4_t y = f32x4_ld(&mY[p]);
+            const float32x4_t r2 = float32x4_add(float32x4_mul(x, x), float32x4_mul(y, y));
+            const float32x4_t gain = float32x4_fmulscaladd(f32x4_dup(1.5f), r2, -0.5f);
+            f32x4_str(&mX[p], float32x4_mul(x, gain));
+            f32x4_str(&mY[p], float32x4_mul(y, gain));
+        }
+    }
+
+private:
+    static constexpr size_t kChunk = 16;
+
+    fast_inline bool IsAudible(int g) const
+    {
+        const int p = g * 4;
+        const float32x4_t a = float32x4_add(si_fabsfx4(f32x4_ld(&mAmp[p])), si_fabsfx4(f32x4_ld(&mAmpTarget[p])));
+        return uint32x4_any(float32x4_gt(a, f32x4_dup(0.f)));
+    }
+
+    float mX[MaxPartials];
+    float mY[MaxPartials];
+    float mCos[MaxPartials];
+    float mSin[MaxPartials];
+    float mCosTarget[MaxPartials];
+    float mSinTarget[MaxPartials];
+    float mW0[MaxPartials];
+    float mW0Target[MaxPartials];
+    float mAmp[MaxPartials];
+    float mAmpTarget[MaxPartials];
+    float mAmpStep[MaxPartials];
+    float mGlideCos[MaxPartials];
+    float mGlideSin[MaxPartials];
+    bool mActive[kGroups];
+    bool mGliding[kGroups];
+};
+
+}
+/** @} */
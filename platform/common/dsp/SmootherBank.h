@@ -0,0 +1,208 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    SmootherBank.h
+ * @brief   N linear parameter smoothers, four per float32x4_t.
+ *
+ * Each lane behaves like a LinearSmoother: SetTarget() restarts a linear ramp
+ * from the current smoothed value, and a q31 phase advanced by the interval
+ * every tick reaches the target exactly and stays there.
+ *
+ * Process() advances all smoothers by one sample, so an effect that smooths
+ * several parameters pays a few vector ops per sample instead of one scalar
+ * call per parameter. Render() writes a whole block of all smoothers,
+ * RenderRamp() a whole block of one smoother, four samples per vector.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <arm_neon.h>
+#include "attributes.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/int_simd.h"
+#include "utils/fixed_math.h"
+
+namespace dsp
+{
+
+template <int N>
+class SmootherBank
+{
+public:
+    static_assert(N % 4 == 0, "N must be a multiple of 4");
+
+    static constexpr int kGroups = N / 4;
+
+    SmootherBank()
+    {
+        for (int i = 0; i < N; i++)
+        {
+            mInitial[i] = 0.f;
+            mTarget[i] = 0.f;
+            mValue[i] = 0.f;
+            mPhase[i] = 0;
+            mInterval[i] = 0x01FFFFFF; // 1 / 64
+        }
+    }
+
+    void Flush(int index)
+    {
+        mValue[index] = mInitial[index] = mTarget[index];
+        mPhase[index] = 0;
+    }
+
+    void Flush()
+    {
+        for (int i = 0; i < N; i++)
+            Flush(i);
+    }
+
+    void SetTarget(int index, float value)
+    {
+        if (value != mTarget[index])
+        {
+            mPhase[index] = 0;
+            mInitial[index] = mValue[index];
+            mTarget[index] = value;
+        }
+    }
+
+    // normalized 0~1
+    void SetInterval(int index, float interval)
+    {
+        mInterval[index] = interval * 0x7FFFFFFF;
+        mPhase[index] = (interval == 1.f) ? kPhaseMax : mPhase[index];
+    }
+
+    // if value is already known
+    void SetInterval(int index, int32_t interval)
+    {
+        mInterval[index] = interval;
+        mPhase[index] = (interval == kPhaseMax) ? kPhaseMax : mPhase[index];
+    }
+
+    // number of ticks until the smoothed value converges with the target
+    void SetIntervalPeriods(int index, int periods)
+    {
+        mInterval[index] = (1.f / periods) * 0x7FFFFFFF;
+    }
+
+    float GetTarget(int index) const { return mTarget[index]; }
+    float GetSmoothedValue(int index) const { return mValue[index]; }
+
+    // smoothed values of smoothers first to first + 3
+    fast_inline float32x4_t GetSmoothedValueX4(int first) const { return f32x4_ld(&mValue[first]); }
+
+    // advances all smoothers by one tick
+    fast_inline void Process()
+    {
+        for (int i = 0; i < N; i += 4)
+            ProcessX4(i);
+    }
+
+    // advances smoothers first to first + 3 by one tick, first is a multiple of 4.
+    // Phase and interval are at most kPhaseMax, so their sum cannot wrap
+    fast_inline float32x4_t ProcessX4(int first)
+    {
+        const uint32x4_t phase = u32x4_ld(reinterpret_cast<const uint32_t *>(&mPhase[first]));
+        const float32x4_t initial = f32x4_ld(&mInitial[first]);
+        const float32x4_t frac = float32x4_mulscal(vcvtq_f32_u32(phase), q31_to_f32_c);
+        const float32x4_t value = float32x4_fmuladd(initial, frac, float32x4_sub(f32x4_ld(&mTarget[first]), initial));
+        f32x4_str(&mValue[first], value);
+
+        const uint32x4_t next = vaddq_u32(phase, u32x4_ld(reinterpret_cast<const uint32_t *>(&mInterval[first])));
+        u32x4_str(reinterpret_cast<uint32_t *>(&mPhase[first]), vminq_u32(next, u32x4_dup(kPhaseMax)));
+        return value;
+    }
+
+    // frames ticks, writes frames * N values, interleaved by smoother
+    void Render(float * out, size_t frames)
+    {
+        for (size_t f = 0; f < frames; f++, out += N)
+        {
+            for (int i = 0; i < N; i += 4)
+                f32x4_str(&out[i], ProcessX4(i));
+        }
+    }
+
+    // frames ticks of one smoother, the others are left where they are
+    void RenderRamp(int index, float * out, size_t frames)
+    {
+        const float initial = mInitial[index];
+        const float delta = mTarget[index] - initial;
+        const uint32_t phase = static_cast<uint32_t>(mPhase[index]);
+        const uint32_t interval = static_cast<uint32_t>(mInterval[index]);
+
+        // the phase of frame n is phase + n * interval clipped to kPhaseMax, in float
+        // so that four frames ahead cannot wrap
+        const float32x4_t frac0 = float32x4_fmulscaladd(f32x4_dup(phase * q31_to_f32_c), float32x4(0.f, 1.f, 2.f, 3.f), interval * q31_to_f32_c);
+        const float32x4_t fracStep = f32x4_dup(4.f * interval * q31_to_f32_c);
+        const float32x4_t fracMax = f32x4_dup(kPhaseMax * q31_to_f32_c);
+        float32x4_t frac = frac0;
+
+        size_t f = 0;
+        for (; f + 4 <= frames; f += 4)
+        {
+            f32x4_str(&out[f], float32x4_fmulscaladd(f32x4_dup(initial), float32x4_min(frac, fracMax), delta));
+            frac = float32x4_add(frac, fracStep);
+        }
+        for (; f < frames; f++)
+        {
+            const float fr = clipmaxf((phase + static_cast<float>(f) * interval) * q31_to_f32_c, kPhaseMax * q31_to_f32_c);
+            out[f] = linintf(fr, initial, mTarget[index]);
+        }
+
+        const uint64_t next = phase + static_cast<uint64_t>(frames) * interval;
+        mPhase[index] = static_cast<int32_t>((next > kPhaseMax) ? kPhaseMax : next);
+        mValue[index] = (frames > 0) ? out[frames - 1] : mValue[index];
+    }
+
+private:
+    static constexpr uint32_t kPhaseMax = 0x7FFFFFFF;
+
+    float mInitial[N];
+    float mTarget[N];
+    float mValue[N];
+    int32_t mPhase[N];
+    int32_t mInterval[N];
+};
+
+}
+/** @} */
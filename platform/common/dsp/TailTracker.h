@@ -0,0 +1,164 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    TailTracker.h
+ * @brief   Detects when a time based effect has gone silent so processing can be skipped.
+ *
+ * Call ProcessInput() at the start of each render callback. If IsIdle() returns
+ * true the effect may skip its processing and write dry passthrough (or zeros).
+ * Otherwise, process normally and call ProcessOutput() with the result.
+ *
+ * The effect becomes idle once the input peak has stayed below the threshold for
+ * at least the tail length and the energy of the last processed block is also
+ * below the threshold. The energy check catches tail estimates that are too
+ * short, e.g. a delay close to self oscillation. Any input above the threshold
+ * wakes the effect up before that block is processed, so the effect resumes
+ * exactly where it stopped.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <arm_neon.h>
+
+namespace dsp
+{
+
+class TailTracker
+{
+public:
+    TailTracker():
+    mThreshold(0.000001f), // -120 dB
+    mTailFrames(48000),
+    mSilentFrames(0),
+    mIdle(false)
+    {
+    }
+
+    // Wake up and restart silence detection
+    void Reset()
+    {
+        mSilentFrames = 0;
+        mIdle = false;
+    }
+
+    // Time in frames for the output to decay below threshold after input stops
+    void SetTailLength(uint32_t frames)
+    {
+        mTailFrames = frames;
+    }
+
+    // linear amplitude
+    void SetThreshold(float threshold)
+    {
+        mThreshold = threshold;
+    }
+
+    // in: interleaved stereo
+    void ProcessInput(const float * in, size_t frames)
+    {
+        if (Peak(in, frames << 1) > mThreshold)
+        {
+            mSilentFrames = 0;
+            mIdle = false;
+            return;
+        }
+
+        // saturate instead of wrapping around after ~24h of silence
+        const uint32_t silentFrames = mSilentFrames + frames;
+        mSilentFrames = (silentFrames < mSilentFrames) ? mSilentFrames : silentFrames;
+    }
+
+    // out: interleaved stereo, as written by the full processing path
+    void ProcessOutput(const float * out, size_t frames)
+    {
+        if (mIdle || mSilentFrames < mTailFrames)
+            return;
+
+        const size_t samples = frames << 1;
+        mIdle = Energy(out, samples) < (mThreshold * mThreshold) * samples;
+    }
+
+    bool IsIdle() const
+    {
+        return mIdle;
+    }
+
+private:
+    static float Peak(const float * x, size_t samples)
+    {
+        float32x4_t peak = vdupq_n_f32(0.f);
+        size_t i = 0;
+        for (; i + 4 <= samples; i += 4)
+            peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(x + i)));
+
+        float32x2_t peak2 = vpmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+        float result = vget_lane_f32(vpmax_f32(peak2, peak2), 0);
+        for (; i < samples; i++)
+        {
+            const float a = (x[i] < 0.f) ? -x[i] : x[i];
+            result = (a > result) ? a : result;
+        }
+        return result;
+    }
+
+    static float Energy(const float * x, size_t samples)
+    {
+        float32x4_t acc = vdupq_n_f32(0.f);
+        size_t i = 0;
+        for (; i + 4 <= samples; i += 4)
+        {
+            const float32x4_t v = vld1q_f32(x + i);
+            acc = vmlaq_f32(acc, v, v);
+        }
+
+        float32x2_t acc2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+        float result = vget_lane_f32(vpadd_f32(acc2, acc2), 0);
+        for (; i < samples; i++)
+            result += x[i] * x[i];
+        return result;
+    }
+
+    float mThreshold;
+    uint32_t mTailFrames;
+    uint32_t mSilentFrames;
+    bool mIdle;
+};
+
+}
+/** @} */
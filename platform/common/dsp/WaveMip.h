@@ -0,0 +1,259 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    WaveMip.h
+ * @brief   Band-limited mip levels of a 128 sample bank wave.
+ *
+ * Level n keeps the harmonics of the wave up to kSize >> (n + 1), and can be
+ * scanned alias-free up to a phase increment of 2^n / kSize. Level 0 is the
+ * original wave.
+ *
+ * The levels are built progressively from the render callback: SetWave()
+ * only records the wave, and each Build() call adds a few harmonics, one DFT
+ * bin and its resynthesis per step. Until the build completes the mip scans
+ * the raw wave, so a wave change aliases for a few blocks at most instead of
+ * stalling the audio thread for the whole transform.
+ *
+ * GetLevel() picks the two levels bracketing a phase increment once per block,
+ * and Scan() crossfades between them per sample.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include <cmath>
+#include <cstdint>
+
+namespace dsp
+{
+
+class WaveMip
+{
+public:
+    enum {
+        kSizeExp = 7,
+        kSize = 1 << kSizeExp,      // k_waves_size
+        kMask = kSize - 1,
+        kNumLevels = 7,
+        kNumHarmonics = kSize >> 2, // highest harmonic kept by level 1
+        kNumSteps = kNumHarmonics + 1
+    };
+
+    struct Level
+    {
+        const float * lo;
+        const float * hi;
+        float frac;
+    };
+
+    WaveMip():
+    mWave(nullptr),
+    mStep(kNumSteps)
+    {
+    }
+
+    // wave holds kSize samples and must stay valid, e.g. wavesA[0]
+    void SetWave(const float * wave)
+    {
+        mWave = wave;
+        mStep = 0;
+    }
+
+    const float * GetWave() const
+    {
+        return mWave;
+    }
+
+    bool IsReady() const
+    {
+        return mStep == kNumSteps;
+    }
+
+    // Runs up to steps build steps of about 4 * kSize multiply-adds each,
+    // kNumSteps complete a build. Returns IsReady()
+    bool Build(uint32_t steps)
+    {
+        for (; steps > 0 && mStep < kNumSteps; steps--, mStep++)
+        {
+            if (mStep == 0)
+                BuildDc();
+            else
+                BuildHarmonic(mStep);
+        }
+        return IsReady();
+    }
+
+    // Levels bracketing phase increment w0, once per block.
+    // Both point at the raw wave until the build completes
+    Level GetLevel(float w0) const
+    {
+        Level level;
+        if (!IsReady())
+        {
+            level.lo = mWave;
+            level.hi = mWave;
+            level.frac = 0.f;
+            return level;
+        }
+
+        // level 0 below w0 = 1 / (2 * kSize), one level per octave above
+        const float x = w0 * (2 * kSize);
+        float l = (x > 1.f) ? log2f(x) : 0.f;
+        l = (l < kNumLevels - 1) ? l : kNumLevels - 1;
+        const uint32_t l0 = static_cast<uint32_t>(l);
+        const uint32_t l1 = (l0 < kNumLevels - 1) ? l0 + 1 : l0;
+        level.lo = &mLevels[l0 << kSizeExp];
+        level.hi = &mLevels[l1 << kSizeExp];
+        level.frac = l - l0;
+        return level;
+    }
+
+    // x is the phase ratio
+    static inline __attribute__((always_inline, optimize("Ofast")))
+    float Scan(const Level & level, float x)
+    {
+        const float p = x - static_cast<uint32_t>(x);
+        const float x0f = p * kSize;
+        const uint32_t x0p = static_cast<uint32_t>(x0f);
+        const float fr = x0f - x0p;
+        const uint32_t x0 = x0p & kMask;
+        const uint32_t x1 = (x0 + 1) & kMask;
+
+        const float lo = level.lo[x0] + fr * (level.lo[x1] - level.lo[x0]);
+        const float hi = level.hi[x0] + fr * (level.hi[x1] - level.hi[x0]);
+        return lo + level.frac * (hi - lo);
+    }
+
+private:
+    static const float * Cosine()
+    {
+        // cos(2 * pi * i / kSize), sin(x) is read a quarter period earlier
+        static const float table[kSize] = {
+            1.000000000e+00f, 9.987954562e-01f, 9.951847267e-01f, 9.891765100e-01f,
+            9.807852804e-01f, 9.700312532e-01f, 9.569403357e-01f, 9.415440652e-01f,
+            9.238795325e-01f, 9.039892931e-01f, 8.819212643e-01f, 8.577286100e-01f,
+            8.314696123e-01f, 8.032075315e-01f, 7.730104534e-01f, 7.409511254e-01f,
+            7.071067812e-01f, 6.715589548e-01f, 6.343932842e-01f, 5.956993045e-01f,
+            5.555702330e-01f, 5.141027442e-01f, 4.713967368e-01f, 4.275550934e-01f,
+            3.826834324e-01f, 3.368898534e-01f, 2.902846773e-01f, 2.429801799e-01f,
+            1.950903220e-01f, 1.467304745e-01f, 9.801714033e-02f, 4.906767433e-02f,
+            6.123233996e-17f, -4.906767433e-02f, -9.801714033e-02f, -1.467304745e-01f,
+            -1.950903220e-01f, -2.429801799e-01f, -2.902846773e-01f, -3.368898534e-01f,
+            -3.826834324e-01f, -4.275550934e-01f, -4.713967368e-01f, -5.141027442e-01f,
+            -5.555702330e-01f, -5.956993045e-01f, -6.343932842e-01f, -6.715589548e-01f,
+            -7.071067812e-01f, -7.409511254e-01f, -7.730104534e-01f, -8.032075315e-01f,
+            -8.314696123e-01f, -8.577286100e-01f, -8.819212643e-01f, -9.039892931e-01f,
+            -9.238795325e-01f, -9.415440652e-01f, -9.569403357e-01f, -9.700312532e-01f,
+            -9.807852804e-01f, -9.891765100e-01f, -9.951847267e-01f, -9.987954562e-01f,
+            -1.000000000e+00f, -9.987954562e-01f, -9.951847267e-01f, -9.891765100e-01f,
+            -9.807852804e-01f, -9.700312532e-01f, -9.569403357e-01f, -9.415440652e-01f,
+            -9.238795325e-01f, -9.039892931e-01f, -8.819212643e-01f, -8.577286100e-01f,
+            -8.314696123e-01f, -8.032075315e-01f, -7.730104534e-01f, -7.409511254e-01f,
+            -7.071067812e-01f, -6.715589548e-01f, -6.343932842e-01f, -5.956993045e-01f,
+            -5.555702330e-01f, -5.141027442e-01f, -4.713967368e-01f, -4.275550934e-01f,
+            -3.826834324e-01f, -3.368898534e-01f, -2.902846773e-01f, -2.429801799e-01f,
+            -1.950903220e-01f, -1.467304745e-01f, -9.801714033e-02f, -4.906767433e-02f,
+            -1.836970199e-16f, 4.906767433e-02f, 9.801714033e-02f, 1.467304745e-01f,
+            1.950903220e-01f, 2.429801799e-01f, 2.902846773e-01f, 3.368898534e-01f,
+            3.826834324e-01f, 4.275550934e-01f, 4.713967368e-01f, 5.141027442e-01f,
+            5.555702330e-01f, 5.956993045e-01f, 6.343932842e-01f, 6.715589548e-01f,
+            7.071067812e-01f, 7.409511254e-01f, 7.730104534e-01f, 8.032075315e-01f,
+            8.314696123e-01f, 8.577286100e-01f, 8.819212643e-01f, 9.039892931e-01f,
+            9.238795325e-01f, 9.415440652e-01f, 9.569403357e-01f, 9.700312532e-01f,
+            9.807852804e-01f, 9.891765100e-01f, 9.951847267e-01f, 9.987954562e-01f,
+        };
+        return table;
+    }
+
+    // the top level only holds the DC offset
+    void BuildDc()
+    {
+        float dc = 0.f;
+        for (uint32_t i = 0; i < kSize; i++)
+            dc += mWave[i];
+        dc *= 1.f / kSize;
+
+        float * top = &mLevels[(kNumLevels - 1) << kSizeExp];
+        for (uint32_t i = 0; i < kSize; i++)
+            top[i] = dc;
+    }
+
+    // Harmonic k first appears in level n = kNumLevels - 1 - ceil(log2(k)). The first
+    // harmonic of a level starts it from a copy of the level above, from the top down.
+    void BuildHarmonic(uint32_t k)
+    {
+        const float * cs = Cosine();
+        const uint32_t quarter = kSize >> 2;
+
+        float re = 0.f;
+        float im = 0.f;
+        for (uint32_t i = 0; i < kSize; i++)
+        {
+            const uint32_t idx = (k * i) & kMask;
+            re += mWave[i] * cs[idx];
+            im += mWave[i] * cs[(idx - quarter) & kMask];
+        }
+        re *= 2.f / kSize;
+        im *= 2.f / kSize;
+
+        const uint32_t order = (k > 1) ? 32 - __builtin_clz(k - 1) : 0;
+        float * level = &mLevels[(kNumLevels - 1 - order) << kSizeExp];
+        if (k > 1 && ((k - 1) & (k - 2)) == 0)
+        {
+            for (uint32_t i = 0; i < kSize; i++)
+                level[i] = level[i + kSize];
+        }
+
+        for (uint32_t i = 0; i < kSize; i++)
+        {
+            const uint32_t idx = (k * i) & kMask;
+            level[i] += re * cs[idx] + im * cs[(idx - quarter) & kMask];
+        }
+
+        if (k == kNumHarmonics)
+        {
+            for (uint32_t i = 0; i < kSize; i++)
+                mLevels[i] = mWave[i];
+        }
+    }
+
+    const float * mWave;
+    uint32_t mStep;
+    float mLevels[kNumLevels * kSize];
+};
+
+}
+/** @} */
@@ -104,3 +104,73 @@ __attribute__((weak)) void unit_aftertouch(uint8_t note, uint8_t mod) {
   (void)note;
   (void)mod;
 }
+
+// Fallback for runtimes passing timestamped events: events are applied at the start of the
+// buffer, as if they had been received through the individual callbacks before unit_render(..).
+// Units override this to apply them at their frame offset, e.g. with unit_render_split_events(..).
+__attribute__((weak)) void unit_render_events(const float * in, float * out, uint32_t frames,
+                                              const unit_event_t * events, uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i)
+    unit_dispatch_event(&events[i]);
+  unit_render(in, out, frames);
+}
+
+// ---- Event helpers ------------------------------------------------------------------------------
+
+// Forwards an event to the callback it stands for
+void unit_dispatch_event(const unit_event_t * event) {
+  switch (event->type) {
+    case k_unit_event_note_on:
+      unit_note_on(event->id, event->mod);
+      break;
+    case k_unit_event_note_off:
+      unit_note_off(event->id);
+      break;
+    case k_unit_event_gate_on:
+      unit_gate_on(event->mod);
+      break;
+    case k_unit_event_gate_off:
+      unit_gate_off();
+      break;
+    case k_unit_event_all_note_off:
+      unit_all_note_off();
+      break;
+    case k_unit_event_param_value:
+      unit_set_param_value(event->id, event->value);
+      break;
+    case k_unit_event_tempo:
+      unit_set_tempo((uint32_t)event->value);
+      break;
+    case k_unit_event_pitch_bend:
+      unit_pitch_bend((uint16_t)event->value);
+      break;
+    case k_unit_event_channel_pressure:
+      unit_channel_pressure(event->mod);
+      break;
+    case k_unit_event_aftertouch:
+      unit_aftertouch(event->id, event->mod);
+      break;
+    default:
+      break;
+  }
+}
+
+// Renders the buffer in segments split at event frames, handling each event between the
+// segments. Events past the end of the buffer are handled after the last segment, out of
+// order ones at the current position. Channel counts are the ones of the runtime descriptor.
+void unit_render_split_events(const float * in, float * out, uint32_t frames,
+                              uint8_t input_channels, uint8_t output_channels,
+                              const unit_event_t * events, uint32_t count,
+                              unit_render_func render, unit_event_handler_func handler) {
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t frame = (events[i].frame < frames) ? events[i].frame : frames;
+    if (frame > offset) {
+      render(in + offset * input_channels, out + offset * output_channels, frame - offset);
+      offset = frame;
+    }
+    handler(&events[i]);
+  }
+  if (offset < frames)
+    render(in + offset * input_channels, out + offset * output_channels, frames - offset);
+}
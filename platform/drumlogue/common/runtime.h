@@ -227,6 +227,45 @@ enum {
   k_unit_err_undef = -32,
 };
 
+/**
+   * Event types for unit_render_events(..), named after the callback they stand for.
+   */
+enum {
+  /** unit_note_on(id, mod) */
+  k_unit_event_note_on = 0U,
+  /** unit_note_off(id) */
+  k_unit_event_note_off,
+  /** unit_gate_on(mod) */
+  k_unit_event_gate_on,
+  /** unit_gate_off() */
+  k_unit_event_gate_off,
+  /** unit_all_note_off() */
+  k_unit_event_all_note_off,
+  /** unit_set_param_value(id, value) */
+  k_unit_event_param_value,
+  /** unit_set_tempo(value) */
+  k_unit_event_tempo,
+  /** unit_pitch_bend(value) */
+  k_unit_event_pitch_bend,
+  /** unit_channel_pressure(mod) */
+  k_unit_event_channel_pressure,
+  /** unit_aftertouch(id, mod) */
+  k_unit_event_aftertouch,
+  k_num_unit_event_types
+};
+
+/** @private */
+#pragma pack(push, 1)
+typedef struct unit_event {
+  uint32_t frame;     // offset in the buffer passed along, events are sorted by frame
+  uint8_t type;       // k_unit_event_*
+  uint8_t id;         // note or parameter index
+  uint8_t mod;        // velocity, pressure or aftertouch
+  uint8_t reserved;
+  int32_t value;      // parameter value, tempo or pitch bend
+} unit_event_t;  // 12 bytes
+#pragma pack(pop)
+
 /** @private */
 typedef int8_t (*unit_init_func)(const unit_runtime_desc_t *);               // sym: unit_init
 typedef void (*unit_teardown_func)();                                        // sym: unit_teardown
@@ -250,6 +289,11 @@ typedef void (*unit_all_note_off_func)(void);                                //
 typedef void (*unit_pitch_bend_func)(uint16_t);                              // sym: unit_pitch_bend
 typedef void (*unit_channel_pressure_func)(uint8_t);                         // sym: unit_channel_pressure
 typedef void (*unit_aftertouch_func)(uint8_t, uint8_t);                      // sym: unit_aftertouch
+typedef void (*unit_render_events_func)(const float *, float *, uint32_t,
+                                        const unit_event_t *, uint32_t);     // sym: unit_render_events (optional)
+
+/** @private */
+typedef void (*unit_event_handler_func)(const unit_event_t *);
 
 #ifdef __cplusplus
 }  // extern "C"
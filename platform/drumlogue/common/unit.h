@@ -42,6 +42,13 @@ void unit_all_note_off(void);
 void unit_pitch_bend(uint16_t);
 void unit_channel_pressure(uint8_t);
 void unit_aftertouch(uint8_t, uint8_t);
+void unit_render_events(const float *, float *, uint32_t, const unit_event_t *, uint32_t);
+
+// Helpers for unit_render_events(..), see _unit_base.c
+void unit_dispatch_event(const unit_event_t *);
+void unit_render_split_events(const float *, float *, uint32_t, uint8_t, uint8_t,
+                              const unit_event_t *, uint32_t,
+                              unit_render_func, unit_event_handler_func);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -17,6 +17,7 @@
 #include <arm_neon.h>
 
 #include "unit.h"  // Note: Include common definitions for all units
+#include "dsp/TailTracker.h"
 
 class Reverb {
  public:
@@ -42,6 +43,10 @@ class Reverb {
 
     // Note: if need to allocate some memory can do it here and return k_unit_err_memory if getting allocation errors
 
+    // Note: longest time the output can keep ringing after input went silent,
+    //       update it if it depends on parameters (feedback, decay time...)
+    tail_tracker_.SetTailLength(24000U);
+
     return k_unit_err_none;
   }
 
@@ -51,6 +56,7 @@ class Reverb {
 
   inline void Reset() {
     // Note: Reset effect state.
+    tail_tracker_.Reset();
   }
 
   inline void Resume() {
@@ -72,11 +78,23 @@ class Reverb {
     float * __restrict out_p = out;
     const float * out_e = out_p + (frames << 1);  // assuming stereo output
 
+    // Note: skip processing once input is silent and the tail has decayed. Effect
+    //       state is left untouched so processing resumes seamlessly on new input.
+    tail_tracker_.ProcessInput(in, frames);
+    if (tail_tracker_.IsIdle()) {
+      // Note: reverb output is wet only, write silence
+      for (; out_p != out_e; out_p += 2)
+        vst1_f32(out_p, vdup_n_f32(0.f));
+      return;
+    }
+
     for (; out_p != out_e; in_p += 2, out_p += 2) {
       // Note: should take advantage of NEON ArmV7 instructions
       float32x2_t sig = vld1_f32(in_p);
       vst1_f32(out_p, vmul_n_f32(sig, 0.f));
     }
+
+    tail_tracker_.ProcessOutput(out, frames);
   }
 
   inline void setParameter(uint8_t index, int32_t value) {
@@ -146,6 +164,8 @@ class Reverb {
 
   float reverb_line_[24000U << 1] __attribute__((aligned(16)));
 
+  dsp::TailTracker tail_tracker_;
+
   /*===========================================================================*/
   /* Private Methods. */
   /*===========================================================================*/
@@ -52,6 +52,14 @@ __unit_callback void unit_render(const float * in, float * out, uint32_t frames)
   s_synth_instance.Render(out, frames);
 }
 
+__unit_callback void unit_render_events(const float * in, float * out, uint32_t frames,
+                                        const unit_event_t * events, uint32_t count) {
+  // Note: Render up to each event and apply it there, so notes start on their exact frame
+  unit_render_split_events(in, out, frames,
+                           s_runtime_desc.input_channels, s_runtime_desc.output_channels,
+                           events, count, unit_render, unit_dispatch_event);
+}
+
 __unit_callback void unit_set_param_value(uint8_t id, int32_t value) {
   s_synth_instance.setParameter(id, value);
 }
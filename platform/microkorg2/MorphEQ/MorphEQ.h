@@ -13,7 +13,9 @@
 #include "dsp/simplelfo.hpp"
 #include "dsp/mk2_biquad.hpp"
 #include "unit_modfx.h"
-#include "dsp/LinearSmoother.h"
+#include "dsp/SmootherBank.h"
+#include "dsp/NeutralState.h"
+#include "dsp/Oversampler.h"
 #include "macros.h"
 #include "utils/mk2_utils.h"
 
@@ -89,6 +91,10 @@ public:
     if (desc->input_channels != 2 || desc->output_channels != 2)  // should be stereo input/output
       return k_unit_err_geometry;
 
+    // the spread ramp is rendered for a whole buffer at a time
+    if (desc->frames_per_buffer > kMk2BufferSize)
+      return k_unit_err_geometry;
+
     // If SDRAM buffers are required they must be allocated here
     // if (!desc->hooks.sdram_alloc)
     //   return k_unit_err_memory;
@@ -109,16 +115,15 @@ public:
       params_[i] = unit_header.params[i].init;
     }
 
-    mGainSmootherLow.Flush();
-    mGainSmootherMid.Flush();
-    mGainSmootherHigh.Flush();
-    mSpreadSmoother.Flush();
-    mCutoffSmoother.Flush();
+    mSmoothers.Flush();
 
     mFilter[kLowEQ].flush();
     mFilter[kMidEQ].flush();
     mFilter[kHighEQ].flush();
 
+    // an effect in the chain, keep the added delay short
+    mSatOversampler.SetPreset(dsp::Oversampler<2>::kLowLatency);
+
     mMidCutoffValueStr = stringBuffer;
 
     // set coeffs to passthrough
@@ -156,17 +161,15 @@ public:
 
   inline void Reset() 
   {
-    mGainSmootherLow.Flush();
-    mGainSmootherMid.Flush();
-    mGainSmootherHigh.Flush();
-    mSpreadSmoother.Flush();
-    mCutoffSmoother.Flush();
+    mSmoothers.Flush();
 
     mFilter[kLowEQ].flush();
     mFilter[kMidEQ].flush();
     mFilter[kHighEQ].flush();
 
     mCrossfadeZ = mCrossfadeTarget;
+    mNeutralState.Reset();
+    mSatOversampler.Reset();
   }
 
   inline void Resume() 
@@ -194,30 +197,56 @@ public:
 
     UpdateParameters();
 
+    // skip the filters while all bands are at 0 dB, they would not change the signal
+    mNeutralState.Update(IsNeutral());
+    if (mNeutralState.IsWaking())
+    {
+      // filter state went stale while bypassed, the fade in hides the restart
+      mFilter[kLowEQ].flush();
+      mFilter[kMidEQ].flush();
+      mFilter[kHighEQ].flush();
+    }
+    const bool bypassFilters = mNeutralState.IsBypassed();
+    const bool fadeFilters = mNeutralState.IsFading();
+
+    float spreadRamp[kMk2BufferSize];
+    mSmoothers.RenderRamp(kSmoothSpread, spreadRamp, frames);
+    const float * spread_p = spreadRamp;
+
     float side = 0;
     const float crossfadeDelta = (mCrossfadeTarget - mCrossfadeZ) / frames;
-    for (; out_p != out_e; in_p += 2, out_p += 2) 
+    for (; out_p != out_e; in_p += 2, out_p += 2, spread_p++) 
     {    
-      // process filter bands
-      float32x4_t sig = float32x4(in_p[0], in_p[1], in_p[0], in_p[1]);
-      sig = mFilter[kLowEQ].process_fo_x4(sig, mCoeffs[kLowEQ]); 
-      sig = mFilter[kMidEQ].process_so_x4(sig, mCoeffs[kMidEQ]);
-      sig = mFilter[kHighEQ].process_fo_x4(sig, mCoeffs[kHighEQ]);
-
-      // crossfade between active filter and previous filter
-      mCrossfadeZ += crossfadeDelta;
-      float32x2_t stereoSig = float32x2_mulscal(float32x4_low(sig), (1.f - mCrossfadeZ));
-      stereoSig = float32x2_fmulscaladd(stereoSig, float32x4_high(sig), mCrossfadeZ);
+      float32x2_t stereoSig = f32x2_ld(in_p);
+      if (!bypassFilters)
+      {
+        // process filter bands
+        float32x4_t sig = float32x4(in_p[0], in_p[1], in_p[0], in_p[1]);
+        sig = mFilter[kLowEQ].process_fo_x4(sig, mCoeffs[kLowEQ]); 
+        sig = mFilter[kMidEQ].process_so_x4(sig, mCoeffs[kMidEQ]);
+        sig = mFilter[kHighEQ].process_fo_x4(sig, mCoeffs[kHighEQ]);
+
+        // crossfade between active filter and previous filter
+        mCrossfadeZ += crossfadeDelta;
+        float32x2_t filterSig = float32x2_mulscal(float32x4_low(sig), (1.f - mCrossfadeZ));
+        filterSig = float32x2_fmulscaladd(filterSig, float32x4_high(sig), mCrossfadeZ);
+
+        // fade in from the unfiltered signal after leaving the neutral state
+        const float fade = fadeFilters ? mNeutralState.ProcessFade() : 1.f;
+        stereoSig = float32x2_fmulscaladd(stereoSig, float32x2_sub(filterSig, stereoSig), fade);
+      }
 
       // mid/side spread 
       const float left = f32x2_lane(stereoSig, 0);
       const float right = f32x2_lane(stereoSig, 1);
       float mid = (left + right) * 0.5;
-      side = (right - left) * mSpreadSmoother.Process();
+      side = (right - left) * *spread_p;
         
       // soft clip here to account for large gain from EQ
-      out_p[0] = fx_sat_cubicf(clipminmaxf(-1.f, mid + side, 1.f));
-      out_p[1] = fx_sat_cubicf(clipminmaxf(-1.f, mid - side, 1.f));
+      // at 2x so that the clipper does not fold back into the audio band
+      const auto clip = [](float x) { return fx_sat_cubicf(clipminmaxf(-1.f, x, 1.f)); };
+      out_p[0] = mSatOversampler.ProcessX1(mid + side, clip, 0);
+      out_p[1] = mSatOversampler.ProcessX1(mid - side, clip, 1);
     }
     mCrossfadeZ = mCrossfadeTarget;
   }
@@ -303,14 +332,23 @@ public:
       kNumChannels
   };
 
+  // the first four are smoothed at block rate with ProcessX4(), spread per sample with RenderRamp()
+  enum
+  {
+      kSmoothLowGain,
+      kSmoothMidGain,
+      kSmoothHighGain,
+      kSmoothCutoffScale,
+      kSmoothSpread,
+      kNumSmoothers
+  };
+
   int32_t params_[kNumParams];
   unit_runtime_desc_t runtime_desc_;
 
-  dsp::LinearSmoother mGainSmootherLow;
-  dsp::LinearSmoother mGainSmootherMid;
-  dsp::LinearSmoother mGainSmootherHigh;
-  dsp::LinearSmoother mSpreadSmoother;
-  dsp::LinearSmoother mCutoffSmoother;
+  dsp::SmootherBank<8> mSmoothers; // kNumSmoothers, rounded up to whole vectors
+  dsp::NeutralState mNeutralState;
+  dsp::Oversampler<2> mSatOversampler;
 
   dsp::ParallelExtBiQuad<kNumChannels> mFilter[kNumBands]; 
   dsp::ParallelExtBiQuad<kNumChannels>::ParallelCoeffs mCoeffs[kNumBands];
@@ -349,22 +387,26 @@ public:
     const float paramSpread = clip01f(si_fabsf(spread) * 2.f);
     const float cutoffSpread = 1.f - 0.2 * paramSpread;
     const float gainSpread = 1.f - 0.05 * paramSpread;
-    mSpreadSmoother.SetTarget(si_fabsf(spread));
+    mSmoothers.SetTarget(kSmoothSpread, si_fabsf(spread));
     
     bool needsUpdate = (mPreviousSpread != spread);
     mPreviousSpread = spread;
 
     const float gainScale = params_[kParamGainScale] * 0.01;
-    mGainSmootherLow.SetTarget((params_[kParamLowGain] * 0.1) * gainScale);
-    mGainSmootherMid.SetTarget((params_[kParamMidGain] * 0.1) * gainScale);
-    mGainSmootherHigh.SetTarget((params_[kParamHighGain] * 0.1) * gainScale);
-
-    const float previousLowGain = mGainSmootherLow.GetSmoothedValue();
-    const float previousMidGain = mGainSmootherMid.GetSmoothedValue();
-    const float previousHighGain = mGainSmootherHigh.GetSmoothedValue();
-    const float lowGainDB = mGainSmootherLow.Process();
-    const float midGainDB = mGainSmootherMid.Process();
-    const float highGainDB = mGainSmootherHigh.Process();
+    mSmoothers.SetTarget(kSmoothLowGain, (params_[kParamLowGain] * 0.1) * gainScale);
+    mSmoothers.SetTarget(kSmoothMidGain, (params_[kParamMidGain] * 0.1) * gainScale);
+    mSmoothers.SetTarget(kSmoothHighGain, (params_[kParamHighGain] * 0.1) * gainScale);
+    mSmoothers.SetTarget(kSmoothCutoffScale, CookCutoffScale(params_[kParamCutoffScale]));
+
+    // gains and cutoff scale advance once per block, in one vector step
+    const float previousLowGain = mSmoothers.GetSmoothedValue(kSmoothLowGain);
+    const float previousMidGain = mSmoothers.GetSmoothedValue(kSmoothMidGain);
+    const float previousHighGain = mSmoothers.GetSmoothedValue(kSmoothHighGain);
+    const float previousCutoffScale = mSmoothers.GetSmoothedValue(kSmoothCutoffScale);
+    mSmoothers.ProcessX4(kSmoothLowGain);
+    const float lowGainDB = mSmoothers.GetSmoothedValue(kSmoothLowGain);
+    const float midGainDB = mSmoothers.GetSmoothedValue(kSmoothMidGain);
+    const float highGainDB = mSmoothers.GetSmoothedValue(kSmoothHighGain);
 
     needsUpdate |= (previousLowGain != lowGainDB || previousMidGain != midGainDB || previousHighGain != highGainDB);
 
@@ -376,10 +418,7 @@ public:
     midCutoff *= midCutoff;
     midCutoff = (mMaxMidFc - mMinMidFc) * midCutoff + mMinMidFc;
 
-    const float previousCutoffScale = mCutoffSmoother.GetSmoothedValue();
-    const float target = CookCutoffScale(params_[kParamCutoffScale]);
-    mCutoffSmoother.SetTarget(target);
-    const float cutoffScale = mCutoffSmoother.Process(); 
+    const float cutoffScale = mSmoothers.GetSmoothedValue(kSmoothCutoffScale);
     const float lowCutoff = clipminmaxf(40.f, mLowCutoff * cutoffScale, 18000.f);
     const float highCutoff = clipminmaxf(40.f, mHighCutoff * cutoffScale, 18000.f);
     mMidCutoff = clipminmaxf(40.f, midCutoff * cutoffScale, 18000.f);
@@ -442,6 +481,14 @@ public:
     }
   }
 
+  // All band gains have settled at 0 dB
+  fast_inline bool IsNeutral()
+  {
+    return mSmoothers.GetTarget(kSmoothLowGain) == 0.f && mSmoothers.GetSmoothedValue(kSmoothLowGain) == 0.f
+        && mSmoothers.GetTarget(kSmoothMidGain) == 0.f && mSmoothers.GetSmoothedValue(kSmoothMidGain) == 0.f
+        && mSmoothers.GetTarget(kSmoothHighGain) == 0.f && mSmoothers.GetSmoothedValue(kSmoothHighGain) == 0.f;
+  }
+
   fast_inline float CookCutoffScale(int32_t paramValue)
   {
     const float cutoffScaleParamMultiplier = 1.f / (unit_header.params[kParamCutoffScale].max - unit_header.params[kParamCutoffScale].min);
@@ -51,7 +51,11 @@
 #include "runtime.h"
 #include "unit_delfx.h"
 #include "macros.h"
-#include "dsp/LinearSmoother.h"
+#include "dsp/SmootherBank.h"
+#include "dsp/SdramArena.h"
+#include "dsp/ProgressiveClear.h"
+#include "dsp/TailTracker.h"
+#include "dsp/NeutralState.h"
 #include "dsp/delayline.hpp"
 #include "dsp/mk2_biquad.hpp"
 
@@ -83,7 +87,8 @@ class MultitapDelay {
 
   MultitapDelay(void):
   mTempo(120),
-  allocated_buffer_(nullptr),
+  mDelayLineMemory1(nullptr),
+  mDelayLineMemory2(nullptr),
   mDelayTimeSmoothingCoeff(0.005)
   {
 
@@ -122,7 +127,13 @@ class MultitapDelay {
     // microkorg2 handles buffer clearing
     // buf_clr_f32(m, BUFFER_LENGTH);
 
-    allocated_buffer_ = m;
+    mArena.SetMemory(m, BUFFER_LENGTH * sizeof(float));
+
+    const uint32_t delayLineSize = BUFFER_LENGTH >> 1;
+    mDelayLineMemory1 = mArena.Allocate<float>(delayLineSize);
+    mDelayLineMemory2 = mArena.Allocate<float>(delayLineSize);
+    if (!mDelayLineMemory1 || !mDelayLineMemory2)
+      return k_unit_err_memory;
     
     // Cache the runtime descriptor for later use
     runtime_desc_ = *desc;
@@ -135,30 +146,34 @@ class MultitapDelay {
   inline void Teardown() {
     // Note: buffers allocated via sdram_alloc are automatically freed after unit teardown
     // Note: cleanup and release resources if any
-    allocated_buffer_ = nullptr;
+    mArena.SetMemory(nullptr, 0);
+    mDelayLineMemory1 = nullptr;
+    mDelayLineMemory2 = nullptr;
   }
 
   inline void Reset() {
     // Note: Reset effect state, excluding exposed parameter values.
-    float * delayLine = allocated_buffer_;
+    mTailTracker.Reset();
+    mNeutralState.Reset();
 
     mDelayTimeRange = 1.f / float((unit_header.params[kParamDelayTime].max - unit_header.params[kParamDelayTime].min));
 
     const uint32_t delayLineSize = BUFFER_LENGTH >> 1;
 
-    mDelayLine1.setMemory(delayLine, delayLineSize);
-    delayLine += delayLineSize;
-    mDelayLine2.setMemory(delayLine, delayLineSize);
+    mDelayLine1.setMemory(mDelayLineMemory1, delayLineSize);
+    mDelayLine2.setMemory(mDelayLineMemory2, delayLineSize);
 
-    mMixSmoother.SetTarget(params_[kParamWet] * 0.01);
-    mInputSpreadSmoother.SetTarget(params_[kParamInputMix] * 0.01);
-    mOutputSpreadSmoother.SetTarget(params_[kParamSpread] * 0.01);
-    mFilterMixSmoother.SetTarget(params_[kParamTone] < 0);
+    StartProgressiveClear();
 
-    mMixSmoother.Flush();
-    mInputSpreadSmoother.Flush();
-    mOutputSpreadSmoother.Flush();
-    mFilterMixSmoother.Flush();
+    mSmoothers.SetTarget(kSmoothMix, params_[kParamWet] * 0.01);
+    mSmoothers.SetTarget(kSmoothInputSpread, params_[kParamInputMix] * 0.01);
+    mSmoothers.SetTarget(kSmoothOutputSpread, params_[kParamSpread] * 0.01);
+    mSmoothers.SetTarget(kSmoothFilterMix, params_[kParamTone] < 0);
+
+    mSmoothers.Flush(kSmoothMix);
+    mSmoothers.Flush(kSmoothInputSpread);
+    mSmoothers.Flush(kSmoothOutputSpread);
+    mSmoothers.Flush(kSmoothFilterMix);
     mCutoffZ = params_[kParamTone] * 0.01;
 
     mDelayTimeZ[kTap1] = mDelayTime[kTap1];
@@ -170,10 +185,10 @@ class MultitapDelay {
 
     CookFilterCoeffs();
 
-    mPrimaryFeedbackSmoother.SetTarget(CalculatePrimaryFeedback(CalculateFeedback(mDelayTime[kTap2] * mDelayTimeRange)));
-    mSecondaryFeedbackSmoother.SetTarget(CalculateSecondaryFeedback(CalculateFeedback(mDelayTime[kTap3] * mDelayTimeRange)));
-    mPrimaryFeedbackSmoother.Flush();
-    mSecondaryFeedbackSmoother.Flush();
+    mSmoothers.SetTarget(kSmoothPrimaryFeedback, CalculatePrimaryFeedback(CalculateFeedback(mDelayTime[kTap2] * mDelayTimeRange)));
+    mSmoothers.SetTarget(kSmoothSecondaryFeedback, CalculateSecondaryFeedback(CalculateFeedback(mDelayTime[kTap3] * mDelayTimeRange)));
+    mSmoothers.Flush(kSmoothPrimaryFeedback);
+    mSmoothers.Flush(kSmoothSecondaryFeedback);
   }
 
   inline void Resume() {
@@ -195,10 +210,42 @@ class MultitapDelay {
     float * __restrict out_p = out;
     const float * out_e = out_p + (frames << 1);  // assuming stereo output
 
+    // fully dry, the wet path does not contribute to the output
+    mNeutralState.Update(params_[kParamWet] == 0 && mSmoothers.GetSmoothedValue(kSmoothMix) == 0.f);
+    if (mNeutralState.IsBypassed())
+    {
+      buf_cpy_f32(in, out, frames << 1);
+      return;
+    }
+    if (mNeutralState.IsWaking())
+    {
+      // delay lines and filters were not fed while bypassed, drop their stale contents.
+      // The wet level ramps up from zero with the mix smoother so no extra fade is needed.
+      StartProgressiveClear();
+      mOutputFilters.flush();
+      mTailTracker.Reset();
+    }
+
+    mTailTracker.ProcessInput(in, frames);
+    if (mTailTracker.IsIdle())
+    {
+      ProcessIdle(in, out, frames);
+      return;
+    }
+
     UpdateParameters();
 
+    mDelayClear1.Process(frames);
+    mDelayClear2.Process(frames);
+
+    // taps 1/3 read delay line 1, taps 2/4 delay line 2
+    const float readLimit1 = mDelayClear1.GetReadLimit();
+    const float readLimit2 = mDelayClear2.GetReadLimit();
+    const float32x4_t readLimit = float32x4(readLimit1, readLimit2, readLimit1, readLimit2);
+
     const float feedbackScale = 0.5325f;
     float wetSig[4];
+    float readTime[4];
     float32x4_t delayTimeZ = f32x4_ld(mDelayTimeZ);
     const float32x4_t delayTimeTarget = f32x4_ld(mDelayTime);
     for (; out_p != out_e; in_p += 2, out_p += 2) 
@@ -206,16 +253,21 @@ class MultitapDelay {
       const float dryL = in_p[0];
       const float dryR = in_p[1];
 
+      // all parameter smoothers advance together
+      mSmoothers.Process();
+
       delayTimeZ = float32x4_add(delayTimeZ, float32x4_mulscal(float32x4_sub(delayTimeTarget, delayTimeZ), mDelayTimeSmoothingCoeff));
       f32x4_str(mDelayTimeZ, delayTimeZ);
-      const float tap1 = mDelayLine1.readFrac(mDelayTimeZ[kTap1]);
-      const float tap2 = mDelayLine2.readFrac(mDelayTimeZ[kTap2]);
-      const float tap3 = mDelayLine1.readFrac(mDelayTimeZ[kTap3]);
-      const float tap4 = mDelayLine2.readFrac(mDelayTimeZ[kTap4]);
+      // memory beyond the read limit may not be cleared yet and reads as silence
+      f32x4_str(readTime, float32x4_min(delayTimeZ, readLimit));
+      const float tap1 = mDelayLine1.readFrac(readTime[kTap1]);
+      const float tap2 = mDelayLine2.readFrac(readTime[kTap2]);
+      const float tap3 = mDelayLine1.readFrac(readTime[kTap3]);
+      const float tap4 = mDelayLine2.readFrac(readTime[kTap4]);
       
-      const float inputSpreadMix = mInputSpreadSmoother.Process();
-      const float primaryFeedback = mPrimaryFeedbackSmoother.Process();
-      const float secondaryFeedback = mSecondaryFeedbackSmoother.Process();
+      const float inputSpreadMix = mSmoothers.GetSmoothedValue(kSmoothInputSpread);
+      const float primaryFeedback = mSmoothers.GetSmoothedValue(kSmoothPrimaryFeedback);
+      const float secondaryFeedback = mSmoothers.GetSmoothedValue(kSmoothSecondaryFeedback);
       float tap1Fb = tap1 * primaryFeedback;
       float tap2Fb = tap2 * (primaryFeedback * inputSpreadMix + secondaryFeedback * (1.f - inputSpreadMix));
       float tap3Fb = tap3 * secondaryFeedback;
@@ -239,7 +291,7 @@ class MultitapDelay {
       mDelayLine1.write(delay1In);
       mDelayLine2.write(delay2In);
       
-      const float outputSpread = mOutputSpreadSmoother.Process();
+      const float outputSpread = mSmoothers.GetSmoothedValue(kSmoothOutputSpread);
       const float outputSpreadFast = clipmaxf(outputSpread * 1.5f, 1.f);
       const float primaryTapLevel = (0.3 + 0.45 * outputSpread);
       const float primaryTapLevelFast = (0.3 + 0.45 * outputSpreadFast);
@@ -259,15 +311,17 @@ class MultitapDelay {
       wetSig[3] = wetSig[1];
 
       float32x4_t filterOut = mOutputFilters.process_so_x4(f32x4_ld(out), mOutputFilterCoeffs, 0);
-      const float lpfMix = mFilterMixSmoother.Process();
+      const float lpfMix = mSmoothers.GetSmoothedValue(kSmoothFilterMix);
       const float hpfMix = 1.f - lpfMix;
       filterOut = float32x4_mul(filterOut, float32x4(lpfMix, lpfMix, hpfMix, hpfMix));
       float32x2_t wetSigx2 = float32x2_add(float32x4_high(filterOut), float32x4_low(filterOut));
 
-      const float wet = mMixSmoother.Process();
+      const float wet = mSmoothers.GetSmoothedValue(kSmoothMix);
       const float dry = (1.f - si_fabsf(wet));
       f32x2_str(out_p, float32x2_add(float32x2_mulscal(wetSigx2, wet), float32x2_mulscal(float32x2(dryL, dryR), dry)));
     }
+
+    mTailTracker.ProcessOutput(out, frames);
   }
 
   inline void setParameter(uint8_t index, int32_t value) 
@@ -318,13 +372,24 @@ class MultitapDelay {
       kNumTaps
   };
 
+  enum
+  {
+      kSmoothMix,
+      kSmoothInputSpread,
+      kSmoothOutputSpread,
+      kSmoothPrimaryFeedback,
+      kSmoothSecondaryFeedback,
+      kSmoothFilterMix,
+      kNumSmoothers
+  };
+
   fast_inline void UpdateParameters()
   {
     const float samplerate = runtime_desc_.samplerate;
 
-    mMixSmoother.SetTarget(params_[kParamWet] * 0.01);
-    mInputSpreadSmoother.SetTarget(params_[kParamInputMix] * 0.01);
-    mOutputSpreadSmoother.SetTarget(params_[kParamSpread] * 0.01);
+    mSmoothers.SetTarget(kSmoothMix, params_[kParamWet] * 0.01);
+    mSmoothers.SetTarget(kSmoothInputSpread, params_[kParamInputMix] * 0.01);
+    mSmoothers.SetTarget(kSmoothOutputSpread, params_[kParamSpread] * 0.01);
 
     const float timeScale = (params_[kParamTapTimeScale] * 0.01f);
     const float primaryTapScale = 0.5f + clipmaxf(timeScale, 0.5f);
@@ -337,8 +402,34 @@ class MultitapDelay {
 
     CookFilterCoeffs();
 
-    mPrimaryFeedbackSmoother.SetTarget(CalculatePrimaryFeedback(CalculateFeedback((delayTime * primaryTapScale - 1) * mDelayTimeRange)));
-    mSecondaryFeedbackSmoother.SetTarget(CalculateSecondaryFeedback(CalculateFeedback((delayTime * secondaryTapScale - 1) * mDelayTimeRange)));
+    const float primaryFeedback = CalculatePrimaryFeedback(CalculateFeedback((delayTime * primaryTapScale - 1) * mDelayTimeRange));
+    const float secondaryFeedback = CalculateSecondaryFeedback(CalculateFeedback((delayTime * secondaryTapScale - 1) * mDelayTimeRange));
+    mSmoothers.SetTarget(kSmoothPrimaryFeedback, primaryFeedback);
+    mSmoothers.SetTarget(kSmoothSecondaryFeedback, secondaryFeedback);
+
+    // Number of repeats for the feedback loop to decay by 120 dB, times the longest tap.
+    // Loop gain is capped, the tail tracker's output energy check covers self oscillation.
+    const float loopGain = clipminmaxf(0.001f, 0.5325f * (primaryFeedback + secondaryFeedback), 0.99f);
+    const float repeats = -6.f / (0.30103f * fasterlog2f(loopGain)) + 1.f;
+    const float tailLength = clipmaxf(repeats * mDelayTime[kTap1], 60.f * samplerate);
+    mTailTracker.SetTailLength(static_cast<uint32_t>(tailLength));
+  }
+
+  // 2 x 512 KB is too much to clear in one callback, spread it over the next ones
+  fast_inline void StartProgressiveClear()
+  {
+    mDelayClear1.Start(mDelayLineMemory1, mDelayLine1.mSize, sizeof(float), mDelayLine1.mWriteIdx & mDelayLine1.mMask);
+    mDelayClear2.Start(mDelayLineMemory2, mDelayLine2.mSize, sizeof(float), mDelayLine2.mWriteIdx & mDelayLine2.mMask);
+  }
+
+  // Delay tail has decayed, delay lines and filters are left untouched so that
+  // processing resumes seamlessly once input comes back
+  fast_inline void ProcessIdle(const float * in, float * out, size_t frames)
+  {
+    const float dry = 1.f - si_fabsf(mSmoothers.GetSmoothedValue(kSmoothMix));
+    const float * out_e = out + (frames << 1);
+    for (; out != out_e; in += 2, out += 2)
+      f32x2_str(out, float32x2_mulscal(f32x2_ld(in), dry));
   }
 
   fast_inline float CalculatePrimaryFeedback(const float feedback)
@@ -356,7 +447,7 @@ class MultitapDelay {
     const float inverseSamplerate = 1.f / runtime_desc_.samplerate;
 
     // exponential smoothing
-    mFilterMixSmoother.SetTarget(params_[kParamTone] < 0);
+    mSmoothers.SetTarget(kSmoothFilterMix, params_[kParamTone] < 0);
     float cutoff = params_[kParamTone] * 0.01;
     mCutoffZ += (cutoff - mCutoffZ) * 0.2;
 
@@ -398,12 +489,9 @@ class MultitapDelay {
 
   int32_t params_[kNumParams];
 
-  dsp::LinearSmoother mMixSmoother;
-  dsp::LinearSmoother mInputSpreadSmoother;
-  dsp::LinearSmoother mOutputSpreadSmoother;
-  dsp::LinearSmoother mPrimaryFeedbackSmoother;
-  dsp::LinearSmoother mSecondaryFeedbackSmoother;
-  dsp::LinearSmoother mFilterMixSmoother;
+  dsp::SmootherBank<8> mSmoothers; // kNumSmoothers, rounded up to whole vectors
+  dsp::TailTracker mTailTracker;
+  dsp::NeutralState mNeutralState;
 
   float mCutoffZ;
   float mDelayTimeRange;
@@ -426,7 +514,12 @@ class MultitapDelay {
   dsp::DelayLine mDelayLine1;
   dsp::DelayLine mDelayLine2;
 
-  float * allocated_buffer_;
+  dsp::SdramArena mArena;
+  float * mDelayLineMemory1;
+  float * mDelayLineMemory2;
+
+  dsp::ProgressiveClear mDelayClear1;
+  dsp::ProgressiveClear mDelayClear2;
   
   /*===========================================================================*/
   /* Private Methods. */
@@ -56,6 +56,7 @@
 #include "dsp/LinearSmoother.h"
 #include "dsp/mk2_biquad.hpp"
 #include "dsp/delayline.hpp"
+#include "dsp/ProgressiveClear.h"
 
 class Vibrato 
 {
@@ -193,8 +194,9 @@ class Vibrato
     mDepthSmoother.Flush();
     mDepthSmoother.SetInterval(1.f / (mRuntimeDesc.frames_per_buffer * 16.f));
 
-    // clear handled by microkorg2 system
+    // initial clear handled by microkorg2 system, later resets clear progressively in Process()
     mDelayLine.setMemory(reinterpret_cast<f32pair_t *>(mAllocatedBuffer), BUFFER_LENGTH >> 1);
+    mDelayClear.Start(mAllocatedBuffer, mDelayLine.mSize, sizeof(f32pair_t), mDelayLine.mWriteIdx & mDelayLine.mMask);
 
     mRmsZ[0] = 0;
     mRmsZ[1] = 0;
@@ -208,9 +210,6 @@ class Vibrato
   {
     // Note: Effect will resume and exit suspend state. Usually means the synth
     // was selected and the render callback will be called again
-
-    // Note: If it is required to clear large memory buffers, consider setting a flag
-    //       and trigger an asynchronous progressive clear on the audio thread (Process() handler)
     Reset();
   }
 
@@ -232,6 +231,9 @@ class Vibrato
 
     UpdateParameters();
 
+    mDelayClear.Process(frames);
+    const float readLimit = mDelayClear.GetReadLimit();
+
     const float samplerate = mRuntimeDesc.samplerate * 0.001;
     for (; out_p != out_e; in_p += 2, out_p += 2)
     {
@@ -254,8 +256,8 @@ class Vibrato
       f32x2_str(mLfoZ, float32x2_fmulscaladd(lfoZx2, float32x2_sub(lfo, lfoZx2), mLfoSmoothingCoeff));
       
       float depth = mDepthSmoother.Process();
-      float delayTimeL = (mMinDelayMS + depth * mLfoZ[0]) * samplerate;
-      float delayTimeR = (mMinDelayMS + depth * mLfoZ[1]) * samplerate;
+      float delayTimeL = clipmaxf((mMinDelayMS + depth * mLfoZ[0]) * samplerate, readLimit);
+      float delayTimeR = clipmaxf((mMinDelayMS + depth * mLfoZ[1]) * samplerate, readLimit);
 
       // read delay output
       float delayOutL = mDelayLine.read0Frac(delayTimeL);
@@ -376,6 +378,7 @@ class Vibrato
   dsp::SimpleLFO mLfo;
   dsp::LinearSmoother mDepthSmoother;
   dsp::DualDelayLine mDelayLine;
+  dsp::ProgressiveClear mDelayClear;
 
   float mSineMix;
   float mSineSquareMix;
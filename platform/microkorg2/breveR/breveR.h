@@ -60,7 +60,11 @@
 #include "runtime.h"
 #include "unit_revfx.h"
 #include "macros.h"
-#include "dsp/LinearSmoother.h"
+#include "dsp/SmootherBank.h"
+#include "dsp/SdramArena.h"
+#include "dsp/ProgressiveClear.h"
+#include "dsp/TailTracker.h"
+#include "dsp/NeutralState.h"
 #include "dsp/simplelfo.hpp"
 
 class breveR {
@@ -97,7 +101,6 @@ class breveR {
   mReadIndex2(0),
   mPreDelayTime(0),
   mDiffusionMix(0),
-  allocated_buffer_(nullptr),
   mPreDelayLine(nullptr),
   mCombLine(nullptr),
   mApfLine(nullptr),
@@ -144,12 +147,23 @@ class breveR {
     // microkorg2 handles buffer clearing
     // buf_clr_f32(m, BUFFER_LENGTH);
 
-    allocated_buffer_ = m;
+    mArena.SetMemory(m, BUFFER_LENGTH * sizeof(float));
+
+    // Delay lines are cache line aligned so that the interleaved comb/apf taps
+    // of a single frame never straddle two lines
+    mPreDelayLine = mArena.Allocate<int16_t>(mPreDelaySize, dsp::SdramArena::kAlignCacheLine);
+    mCombLine = mArena.Allocate<int16_t>(mCombSize, dsp::SdramArena::kAlignCacheLine);
+    mApfLine = mArena.Allocate<int16_t>(mApfSize, dsp::SdramArena::kAlignCacheLine);
+    if (!mPreDelayLine || !mCombLine || !mApfLine)
+      return k_unit_err_memory;
     
     // Cache the runtime descriptor for later use
     runtime_desc_ = *desc;
 
     buf_clr_u32(reinterpret_cast<uint32_t *>(params_), kNumParams);
+
+    // the wet path is Q15 and input below ~1 LSB never reaches it, so -90 dB is silence here
+    mTailTracker.SetThreshold(1.f / 32768.f);
     
     return k_unit_err_none;
   }
@@ -157,7 +171,10 @@ class breveR {
   inline void Teardown() {
     // Note: buffers allocated via sdram_alloc are automatically freed after unit teardown
     // Note: cleanup and release resources if any
-    allocated_buffer_ = nullptr;
+    mArena.SetMemory(nullptr, 0);
+    mPreDelayLine = nullptr;
+    mCombLine = nullptr;
+    mApfLine = nullptr;
   }
 
   inline void Reset() {
@@ -165,16 +182,8 @@ class breveR {
     mReverseLfo1.reset();
     mReverseLfo2.reset();
     mReverseLfo2.phi0 = -0x40000000; // offset lfo 2 by 90 degrees
-
-    int16_t * delayLine = reinterpret_cast<int16_t *>(allocated_buffer_);
-    mPreDelayLine = delayLine;
-    delayLine += mPreDelaySize;
-
-    mCombLine = delayLine;
-    delayLine += mCombSize;
-
-    mApfLine = delayLine;
-    delayLine += mApfSize;
+    mTailTracker.Reset();
+    mNeutralState.Reset();
 
     buf_clr_u32(mEarlyReflectionsTimes, 4);
     buf_clr_u32(mCombTimes, 4);
@@ -188,6 +197,8 @@ class breveR {
       mCombGains[i] = 0;    
       mCombLpfCoeffs[i] = 0;
     }
+
+    StartProgressiveClear();
   }
 
   inline void Resume() {
@@ -211,7 +222,32 @@ class breveR {
     float * __restrict out_p = out;
     const float * out_e = out_p + (frames << 1);  // assuming stereo output
 
+    // fully dry, the wet path does not contribute to the output
+    mNeutralState.Update(params_[kParamMix] == 0 && mSmoothers.GetSmoothedValue(kSmoothMix) == 0.f);
+    if (mNeutralState.IsBypassed())
+    {
+      buf_cpy_f32(in, out, frames << 1);
+      return;
+    }
+    if (mNeutralState.IsWaking())
+    {
+      // delay lines were not fed while bypassed, drop their stale contents.
+      // The wet level ramps up from zero with the mix smoother so no extra fade is needed.
+      StartProgressiveClear();
+      mTailTracker.Reset();
+    }
+
+    mTailTracker.ProcessInput(in, frames);
+    if (mTailTracker.IsIdle())
+    {
+      ProcessIdle(in, out, frames);
+      return;
+    }
+
     UpdateParameters();
+    UpdateProgressiveClear(frames);
+
+    const uint32_t preDelayReadLimit = mPreDelayClear.GetReadLimit();
 
     for (; out_p != out_e; in_p += 2, out_p += 2) 
     {
@@ -219,7 +255,8 @@ class breveR {
       const float dryL = in_p[0];
       const float dryR = in_p[1];
 
-      float sig = (dryL + dryR) * mTrimSmoother.Process();
+      mSmoothers.Process();
+      float sig = (dryL + dryR) * mSmoothers.GetSmoothedValue(kSmoothTrim);
       int16_t fixedSig = f32_to_q15(sig) >> 1; // headroom
                               
       // get reverse if switched on
@@ -232,9 +269,13 @@ class breveR {
       int16_t reverseWindow1 = mReverse ? f32_to_q15(si_fabsf(mReverseLfo1.sine_bi())) : 0x7FFF;
       int16_t reverseWindow2 = mReverse ? f32_to_q15(si_fabsf(mReverseLfo2.sine_bi())) : 0x0000;
       
+      // reverse taps are clamped so they never reach memory that is still being cleared
+      const uint32_t reverseTap1 = mWriteIndex + clipmaxu32((mReadIndex1 - mWriteIndex) & mPreDelayMask, preDelayReadLimit);
+      const uint32_t reverseTap2 = mWriteIndex + clipmaxu32((mReadIndex2 - mWriteIndex) & mPreDelayMask, preDelayReadLimit);
+
       mPreDelayLine[mWriteIndex & mPreDelayMask] = fixedSig;
-      int16_t preDelayOut = mReverse ? mPreDelayLine[mReadIndex1 & mPreDelayMask] : mPreDelayLine[(mWriteIndex + mPreDelayTime) & mPreDelayMask];
-      preDelayOut = q15mul(preDelayOut, reverseWindow1) + q15mul(mPreDelayLine[mReadIndex2 & mPreDelayMask], reverseWindow2);
+      int16_t preDelayOut = mReverse ? mPreDelayLine[reverseTap1 & mPreDelayMask] : mPreDelayLine[(mWriteIndex + mPreDelayTime) & mPreDelayMask];
+      preDelayOut = q15mul(preDelayOut, reverseWindow1) + q15mul(mPreDelayLine[reverseTap2 & mPreDelayMask], reverseWindow2);
       
       // parallel comb filters
       int16_t comb1 = mCombLine[((mWriteIndex + mCombTimes[0]) & mCombMask) * 4 + 0];
@@ -296,7 +337,7 @@ class breveR {
       float outL = q15_to_f32(fixedOutL);
       float outR = q15_to_f32(fixedOutR);
 
-      const float wet = mMixSmoother.Process();
+      const float wet = mSmoothers.GetSmoothedValue(kSmoothMix);
       const float dry = 1.f - si_fabsf(wet);      
       out_p[0] = dryL * dry + outL * wet;
       out_p[1] = dryR * dry + outR * wet; 
@@ -307,6 +348,8 @@ class breveR {
       mReadIndex2 = lfo2Reset ? mWriteIndex : mReadIndex2;
       mWriteIndex--;
     }
+
+    mTailTracker.ProcessOutput(out, frames);
   }
 
   inline void setParameter(uint8_t index, int32_t value) 
@@ -361,8 +404,8 @@ class breveR {
   /*===========================================================================*/
   void UpdateParameters()
   {
-    mMixSmoother.SetTarget(params_[kParamMix] * 0.01);
-    mTrimSmoother.SetTarget(params_[kParamDepth] * 0.01);
+    mSmoothers.SetTarget(kSmoothMix, params_[kParamMix] * 0.01);
+    mSmoothers.SetTarget(kSmoothTrim, params_[kParamDepth] * 0.01);
     
     const float size = params_[kParamSize] * 0.01;
     
@@ -464,14 +507,26 @@ class breveR {
     reverseFreq = samplerate / reverseFreq;
     mReverseLfo1.setF0(reverseFreq, inverseSamplerate); 
     mReverseLfo2.setF0(reverseFreq, inverseSamplerate);
+
+    // -120 dB is reached after two reverb times, plus the longest path through the delay lines
+    const float tailLength = 2.f * samplerate / time + mPreDelaySize + mCombMask + mApfMask;
+    mTailTracker.SetTailLength(static_cast<uint32_t>(tailLength));
   }
 
   std::atomic_uint_fast32_t flags_;
 
   unit_runtime_desc_t runtime_desc_;
 
-  dsp::LinearSmoother mMixSmoother;
-  dsp::LinearSmoother mTrimSmoother;
+  enum
+  {
+    kSmoothMix,
+    kSmoothTrim,
+    kNumSmoothers
+  };
+
+  dsp::SmootherBank<4> mSmoothers; // kNumSmoothers, rounded up to a whole vector
+  dsp::TailTracker mTailTracker;
+  dsp::NeutralState mNeutralState;
   dsp::SimpleLFO mReverseLfo1;
   dsp::SimpleLFO mReverseLfo2;
 
@@ -497,7 +552,10 @@ class breveR {
   int16_t mCombLpfCoeffs[4];
   int16_t mApfOutputGains[4];
 
-  float * allocated_buffer_;
+  dsp::SdramArena mArena;
+  dsp::ProgressiveClear mPreDelayClear;
+  dsp::ProgressiveClear mCombClear;
+  dsp::ProgressiveClear mApfClear;
   int16_t * mPreDelayLine;
   int16_t * mCombLine;
   int16_t * mApfLine;
@@ -506,6 +564,44 @@ class breveR {
   /* Private Methods. */
   /*===========================================================================*/
 
+  // Reverb tail has decayed, the delay lines are left untouched so that
+  // processing resumes seamlessly once input comes back
+  void ProcessIdle(const float * in, float * out, size_t frames)
+  {
+    const float dry = 1.f - si_fabsf(mSmoothers.GetSmoothedValue(kSmoothMix));
+    const float * out_e = out + (frames << 1);
+    for (; out != out_e; in += 2, out += 2)
+    {
+      out[0] = in[0] * dry;
+      out[1] = in[1] * dry;
+    }
+  }
+
+  // zero the delay lines over the next callbacks rather than in one go
+  void StartProgressiveClear()
+  {
+    mPreDelayClear.Start(mPreDelayLine, mPreDelaySize, sizeof(int16_t), mWriteIndex & mPreDelayMask);
+    mCombClear.Start(mCombLine, mCombMask + 1, 4 * sizeof(int16_t), mWriteIndex & mCombMask);
+    mApfClear.Start(mApfLine, mApfMask + 1, 4 * sizeof(int16_t), mWriteIndex & mApfMask);
+  }
+
+  // Advance background clearing and pull taps that would read stale memory
+  // back to a position that is known to be silent
+  void UpdateProgressiveClear(size_t frames)
+  {
+    mPreDelayClear.Process(frames);
+    mCombClear.Process(frames);
+    mApfClear.Process(frames);
+
+    mPreDelayTime = mPreDelayClear.MaskDelay(mPreDelayTime);
+    for (int i = 0; i < 4; i++)
+    {
+      mCombTimes[i] = mCombClear.MaskDelay(mCombTimes[i]);
+      mStereoOutTimes[i] = mCombClear.MaskDelay(mStereoOutTimes[i]);
+      mApfTimes[i] = mApfClear.MaskDelay(mApfTimes[i]);
+    }
+  }
+
   /*===========================================================================*/
   /* Constants. */
   /*===========================================================================*/
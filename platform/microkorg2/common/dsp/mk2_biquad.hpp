@@ -48,6 +48,7 @@
 #include "attributes.h"
 #include "utils/float_simd.h"
 #include "utils/buffer_ops.h"
+#include "utils/voice_batch.h"
 
 /**
  * Common DSP Utilities
@@ -111,6 +112,17 @@ namespace dsp
       buf_clr_f32(mZ2, NumParallelFilters);
     }
 
+    /**
+     * Flush internal delays of one filter
+     *
+     * @param filterNumber  Filter to flush
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(int filterNumber) {
+      mZ1[filterNumber] = 0.f;
+      mZ2[filterNumber] = 0.f;
+    }
+
     /**
      * Second order processing of one sample
      *
@@ -130,12 +142,7 @@ namespace dsp
 
     inline __attribute__((optimize("Ofast"),always_inline))
     float process_so_x1(const float xn, ParallelCoeffs & coeffs, int filterNumber = 0) {
-      float acc = coeffs.ff0[filterNumber] * xn + mZ1[filterNumber];
-      mZ1[filterNumber] = coeffs.ff1[filterNumber] * xn + mZ2[filterNumber];
-      mZ2[filterNumber] = coeffs.ff2[filterNumber] * xn;
-      mZ1[filterNumber] -= coeffs.fb1[filterNumber] * acc;
-      mZ2[filterNumber] -= coeffs.fb2[filterNumber] * acc;
-      return acc;
+      return process_so<1>(xn, coeffs, filterNumber);
     }
 
     inline __attribute__((optimize("Ofast"),always_inline))
@@ -150,12 +157,7 @@ namespace dsp
 
     inline __attribute__((optimize("Ofast"),always_inline))
     float32x2_t process_so_x2(const float32x2_t xn, ParallelCoeffs & coeffs, int filterNumber = 0) {
-      float32x2_t acc = float32x2_fmuladd(f32x2_ld(&mZ1[filterNumber]), f32x2_ld(&coeffs.ff0[filterNumber]), xn);
-      float32x2_t z1 = float32x2_fmuladd(f32x2_ld(&mZ2[filterNumber]), f32x2_ld(&coeffs.ff1[filterNumber]), xn);
-      float32x2_t z2 = float32x2_mul(f32x2_ld(&coeffs.ff2[filterNumber]), xn);
-      f32x2_str(&mZ1[filterNumber], float32x2_fmulsub(z1, f32x2_ld(&coeffs.fb1[filterNumber]), acc));
-      f32x2_str(&mZ2[filterNumber], float32x2_fmulsub(z2, f32x2_ld(&coeffs.fb2[filterNumber]), acc));
-      return acc;
+      return process_so<2>(xn, coeffs, filterNumber);
     }
 
     inline __attribute__((optimize("Ofast"),always_inline))
@@ -170,11 +172,26 @@ namespace dsp
 
     inline __attribute__((optimize("Ofast"),always_inline))
     float32x4_t process_so_x4(const float32x4_t xn, ParallelCoeffs & coeffs, int filterNumber = 0) {
-      float32x4_t acc = float32x4_fmuladd(f32x4_ld(&mZ1[filterNumber]), f32x4_ld(&coeffs.ff0[filterNumber]), xn);
-      float32x4_t z1 = float32x4_fmuladd(f32x4_ld(&mZ2[filterNumber]), f32x4_ld(&coeffs.ff1[filterNumber]), xn);
-      float32x4_t z2 = float32x4_mul(f32x4_ld(&coeffs.ff2[filterNumber]), xn);
-      f32x4_str(&mZ1[filterNumber], float32x4_fmulsub(z1, f32x4_ld(&coeffs.fb1[filterNumber]), acc));
-      f32x4_str(&mZ2[filterNumber], float32x4_fmulsub(z2, f32x4_ld(&coeffs.fb2[filterNumber]), acc));
+      return process_so<4>(xn, coeffs, filterNumber);
+    }
+
+    /**
+     * Second order processing of one sample for Lanes filters starting at
+     * filterNumber, with per filter coefficients
+     *
+     * @param xn  Input samples, one per filter
+     *
+     * @return Output samples
+     */
+    template <int Lanes>
+    inline __attribute__((optimize("Ofast"),always_inline))
+    typename VoiceBatch<Lanes>::f32 process_so(const typename VoiceBatch<Lanes>::f32 xn, ParallelCoeffs & coeffs, int filterNumber = 0) {
+      typedef VoiceBatch<Lanes> B;
+      typename B::f32 acc = B::fmuladd(B::ld(&mZ1[filterNumber]), B::ld(&coeffs.ff0[filterNumber]), xn);
+      typename B::f32 z1 = B::fmuladd(B::ld(&mZ2[filterNumber]), B::ld(&coeffs.ff1[filterNumber]), xn);
+      typename B::f32 z2 = B::mul(B::ld(&coeffs.ff2[filterNumber]), xn);
+      B::str(&mZ1[filterNumber], B::fmulsub(z1, B::ld(&coeffs.fb1[filterNumber]), acc));
+      B::str(&mZ2[filterNumber], B::fmulsub(z2, B::ld(&coeffs.fb2[filterNumber]), acc));
       return acc;
     }
 
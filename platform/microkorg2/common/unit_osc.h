@@ -50,6 +50,9 @@
 #include "utils/int_math.h"
 #include "utils/float_math.h"
 #include "utils/mk2_osc_api.h"
+#ifdef __cplusplus
+#include "utils/voice_batch.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -86,66 +89,84 @@ extern "C" {
   // -------------------------------------
   // ------- mod source helpers ----------
   // -------------------------------------
+#ifdef __cplusplus
+} // extern "C"
+
+  // Lanes voices from startVoice, the x1/x2/x4 helpers below forward here
+  template <int Lanes>
+  void WriteUnitModDataPlus(const unit_runtime_osc_context_t * context, typename VoiceBatch<Lanes>::f32 mod, uint8_t startVoice)
+  {
+    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
+    VoiceBatch<Lanes>::str(&context->unitModDataPlus[startVoice], VoiceBatch<Lanes>::clip01(mod));
+  }
+
+  template <int Lanes>
+  void WriteUnitModDataPlusMinus(const unit_runtime_osc_context_t * context, typename VoiceBatch<Lanes>::f32 mod, uint8_t startVoice)
+  {
+    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
+    VoiceBatch<Lanes>::str(&context->unitModDataPlusMinus[startVoice], VoiceBatch<Lanes>::clip1m1(mod));
+  }
+
+  // assumes input is within -1 ~ 1
+  template <int Lanes>
+  void WriteUnitModData(const unit_runtime_osc_context_t * context, typename VoiceBatch<Lanes>::f32 mod, uint8_t startVoice)
+  {
+    typedef VoiceBatch<Lanes> B;
+    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
+    typename B::f32 clipped = B::clip1m1(mod);
+    B::str(&context->unitModDataPlusMinus[startVoice], clipped);
+    B::str(&context->unitModDataPlus[startVoice], B::addscal(B::mulscal(clipped, 0.5f), 0.5f));
+  }
+
+extern "C" {
+#endif
+
   void WriteUnitModDataPlusx1(const unit_runtime_osc_context_t * context, float mod, uint8_t voice)
   {
-    voice = (voice >= context->modDataSize) ? context->modDataSize - 1 : voice;
-    context->unitModDataPlus[voice] = clip01f(mod);
+    WriteUnitModDataPlus<1>(context, mod, voice);
   }
 
   void WriteUnitModDataPlusMinusx1(const unit_runtime_osc_context_t * context, float mod, uint8_t voice)
   {
-    voice = (voice >= context->modDataSize) ? context->modDataSize - 1 : voice;
-    context->unitModDataPlusMinus[voice] = clip1m1f(mod);
+    WriteUnitModDataPlusMinus<1>(context, mod, voice);
   }
 
   // assumes input is within -1 ~ 1
   void WriteUnitModDatax1(const unit_runtime_osc_context_t * context, float mod, uint8_t voice)
   {
-    voice = (voice >= context->modDataSize) ? context->modDataSize - 1 : voice;
-    context->unitModDataPlusMinus[voice] = clip1m1f(mod);
-    context->unitModDataPlus[voice] = context->unitModDataPlusMinus[voice] * 0.5f + 0.5f;
+    WriteUnitModData<1>(context, mod, voice);
   }
 
   void WriteUnitModDataPlusx2(const unit_runtime_osc_context_t * context, float32x2_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    f32x2_str(&context->unitModDataPlus[startVoice], clip01fx2(mod));
+    WriteUnitModDataPlus<2>(context, mod, startVoice);
   }
 
   void WriteUnitModDataPlusMinusx2(const unit_runtime_osc_context_t * context, float32x2_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    f32x2_str(&context->unitModDataPlusMinus[startVoice], clip1m1fx2(mod));
+    WriteUnitModDataPlusMinus<2>(context, mod, startVoice);
   }
 
   // assumes input is within -1 ~ 1
   void WriteUnitModDatax2(const unit_runtime_osc_context_t * context, float32x2_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    float32x2_t clipped = clip01fx2(mod);
-    f32x2_str(&context->unitModDataPlusMinus[startVoice], clipped);
-    f32x2_str(&context->unitModDataPlus[startVoice], float32x2_addscal(float32x2_mulscal(clipped, 0.5f), 0.5f));
+    WriteUnitModData<2>(context, mod, startVoice);
   }
 
   void WriteUnitModDataPlusx4(const unit_runtime_osc_context_t * context, float32x4_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    f32x4_str(&context->unitModDataPlus[startVoice], clip01fx4(mod));
+    WriteUnitModDataPlus<4>(context, mod, startVoice);
   }
 
   void WriteUnitModDataPlusMinusx4(const unit_runtime_osc_context_t * context, float32x4_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    f32x4_str(&context->unitModDataPlusMinus[startVoice], clip1m1fx4(mod));
+    WriteUnitModDataPlusMinus<4>(context, mod, startVoice);
   }
 
   // assumes input is within -1 ~ 1
   void WriteUnitModDatax4(const unit_runtime_osc_context_t * context, float32x4_t mod, uint8_t startVoice)
   {
-    startVoice = clipminmaxi32(0, startVoice, context->modDataSize - 1);
-    float32x4_t clipped = clip01fx4(mod);
-    f32x4_str(&context->unitModDataPlusMinus[startVoice], clipped);
-    f32x4_str(&context->unitModDataPlus[startVoice], float32x4_addscal(float32x4_mulscal(clipped, 0.5f), 0.5f));
+    WriteUnitModData<4>(context, mod, startVoice);
   }
   
 #ifdef __cplusplus
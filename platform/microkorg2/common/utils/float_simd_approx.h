@@ -0,0 +1,125 @@
+/**
+ * @file    float_simd_approx.h
+ * @brief   Approximations and lane tests on top of the floating point SIMD utilities.
+ *
+ * @addtogroup utils Utils
+ * @{
+ *
+ * @addtogroup utils_float_simd_approx Floating-Point SIMD approximations
+ * @{
+ *
+ * ARMv7 NEON has no vector divide and no across-lane reductions, these
+ * helpers fill the gap for the dsp banks that process four voices or
+ * partials at a time.
+ */
+
+#ifndef __mk2_float_simd_approx_h
+#define __mk2_float_simd_approx_h
+
+#include <math.h>
+#include <stdint.h>
+
+#include "float_simd.h"
+#include "int_simd.h"
+
+/**
+ * @name    Division
+ * @{
+ */
+
+/** Reciprocal, estimate refined by two Newton-Raphson steps
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float32x4_t
+float32x4_rcp_nr(const float32x4_t x) {
+  float32x4_t r = float32x4_rcp(x);
+  r = float32x4_mul(r, float32x4_sub(f32x4_dup(2.f), float32x4_mul(x, r)));
+  r = float32x4_mul(r, float32x4_sub(f32x4_dup(2.f), float32x4_mul(x, r)));
+  return r;
+}
+
+/** Division, as num times the refined reciprocal of den
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float32x4_t
+float32x4_div_nr(const float32x4_t num, const float32x4_t den) {
+  return float32x4_mul(num, float32x4_rcp_nr(den));
+}
+
+/** @} */
+
+/**
+ * @name    Lane tests
+ * @{
+ */
+
+/** Non-zero if any lane of the mask is set
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+uint32_t
+uint32x4_any(const uint32x4_t m) {
+#if defined(NEON_SIMD_INT)
+  const uint32x2_t h = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+  return vget_lane_u32(h, 0) | vget_lane_u32(h, 1);
+#else
+  return m.val[0] | m.val[1] | m.val[2] | m.val[3];
+#endif
+}
+
+/** @} */
+
+/**
+ * @name    Trigonometry
+ * @{
+ */
+
+/** Sine for x in [-pi/2, pi/2], odd Taylor series up to x^11
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float32x4_t
+fastsinhalffx4(const float32x4_t x) {
+  const float32x4_t x2 = float32x4_mul(x, x);
+  float32x4_t p = float32x4_fmulscaladd(f32x4_dup(1.f), x2, -1.f / 110.f);
+  p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(x2, p), -1.f / 72.f);
+  p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(x2, p), -1.f / 42.f);
+  p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(x2, p), -1.f / 20.f);
+  p = float32x4_fmulscaladd(f32x4_dup(1.f), float32x4_mul(x2, p), -1.f / 6.f);
+  return float32x4_mul(x, p);
+}
+
+/** Cosine and sine for a in (-pi, pi], folded onto fastsinhalffx4()
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+void
+fastsincosfx4(const float32x4_t a, float32x4_t * c, float32x4_t * s) {
+  const float32x4_t half_pi = f32x4_dup(0.5f * M_PI);
+  const float32x4_t m = si_fabsfx4(a);
+  const float32x4_t sm = fastsinhalffx4(float32x4_sub(half_pi, si_fabsfx4(float32x4_sub(m, half_pi))));
+  *s = float32x4_sel(float32x4_ltz(a), float32x4_neg(sm), sm);
+  *c = fastsinhalffx4(float32x4_sub(half_pi, m));
+}
+
+/** Sine of pi * x for x in [-1, 1), folded onto [-0.5, 0.5], odd Taylor series up to x^9
+ *
+ * Max error 4e-6. Takes a q31 phase converted to float directly.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float32x4_t
+fastsinpifx4(const float32x4_t x) {
+  const float32x4_t a = si_fabsfx4(x);
+  const float32x4_t f = float32x4_sub(f32x4_dup(0.5f), si_fabsfx4(float32x4_subscal(a, 0.5f)));
+  const float32x4_t f2 = float32x4_mul(f, f);
+  float32x4_t p = float32x4_fmulscaladd(f32x4_dup(-0.5992645f), f2, 0.0821459f); // -pi^7/7!, pi^9/9!
+  p = float32x4_fmuladd(f32x4_dup(2.5501640f), f2, p);                            // pi^5/5!
+  p = float32x4_fmuladd(f32x4_dup(-5.1677128f), f2, p);                           // -pi^3/3!
+  p = float32x4_fmuladd(f32x4_dup(3.1415927f), f2, p);                            // pi
+  const float32x4_t y = float32x4_mul(f, p);
+  return float32x4_sel(float32x4_ltz(x), float32x4_neg(y), y);
+}
+
+/** @} */
+
+/** @} */
+/** @} */
+
+#endif // __mk2_float_simd_approx_h
@@ -62,6 +62,109 @@
     return float32x4_mulscal(f, k_samplerate_recipf);
   }
 
+  /**
+   * Sine wave lookup for four phases
+   *
+   * @param x  Phase ratio per lane.
+   * @return   sin(2*pi*x) per lane.
+   */
+  static fast_inline float32x4_t osc_sinfx4(float32x4_t x) 
+  {
+    const float32x4_t p = float32x4_sub(x, si_u32x4_to_f32x4(si_f32x4_to_u32x4(x)));
+
+    // half period stored -- wrap around and invert
+    const float32x4_t x0f = float32x4_mulscal(p, 2.f * k_wt_sine_size);
+    const uint32x4_t x0p = si_f32x4_to_u32x4(x0f);
+    const float32x4_t fr = float32x4_sub(x0f, si_u32x4_to_f32x4(x0p));
+
+    uint32_t x0[4];
+    u32x4_str(x0, uint32x4_and(x0p, u32x4_dup(k_wt_sine_mask)));
+    const float32x4_t y0 = float32x4(wt_sine_lut_f[x0[0]], wt_sine_lut_f[x0[1]],
+                                     wt_sine_lut_f[x0[2]], wt_sine_lut_f[x0[3]]);
+    const float32x4_t y1 = float32x4(wt_sine_lut_f[x0[0] + 1], wt_sine_lut_f[x0[1] + 1],
+                                     wt_sine_lut_f[x0[2] + 1], wt_sine_lut_f[x0[3] + 1]);
+    const float32x4_t y = linintfx4(fr, y0, y1);
+    return float32x4_sel(uint32x4_lt(x0p, u32x4_dup(k_wt_sine_size)), y, float32x4_neg(y));
+  }
+
+  /**
+   * Band-limited sawtooth wave lookup for four phases (interpolated version)
+   *
+   * @param x    Phase ratio per lane.
+   * @param idx  Fractional wave index in [0,6] per lane, see osc_bl_saw_idx().
+   * @return     Wave sample per lane.
+   */
+  static fast_inline float32x4_t osc_bl2_sawfx4(float32x4_t x, float32x4_t idx) 
+  {
+    const float32x4_t p = float32x4_sub(x, si_u32x4_to_f32x4(si_f32x4_to_u32x4(x)));
+
+    // half period stored -- reverse and invert for the second half
+    const float32x4_t x0f = float32x4_mulscal(p, 2.f * k_wt_saw_size);
+    const uint32x4_t x0p = si_f32x4_to_u32x4(x0f);
+    const float32x4_t fr = float32x4_sub(x0f, si_u32x4_to_f32x4(x0p));
+    const uint32x4_t second = uint32x4_gte(x0p, u32x4_dup(k_wt_saw_size));
+    const uint32x4_t x0r = uint32x4_sub(u32x4_dup(k_wt_saw_size), uint32x4_and(x0p, u32x4_dup(k_wt_saw_mask)));
+
+    const uint32x4_t idx0 = si_f32x4_to_u32x4(clipminmaxfx4(f32x4_dup(0.f), idx, f32x4_dup(k_wt_saw_notes_cnt - 1)));
+    const float32x4_t idx_fr = float32x4_sub(idx, si_u32x4_to_f32x4(idx0));
+    const uint32x4_t base = uint32x4_mulscal(idx0, k_wt_saw_lut_size);
+
+    uint32_t i0[4], i1[4], b[4];
+    u32x4_str(i0, uint32x4_add(base, uint32x4_sel(second, x0r, x0p)));
+    u32x4_str(i1, uint32x4_add(base, uint32x4_sel(second, uint32x4_sub(x0r, u32x4_dup(1)), uint32x4_add(x0p, u32x4_dup(1)))));
+    u32x4_str(b, idx0);
+
+    // the next band is only read where it exists
+    uint32_t n[4];
+    for (int i = 0; i < 4; i++)
+      n[i] = (b[i] < k_wt_saw_notes_cnt - 1) ? k_wt_saw_lut_size : 0;
+
+    const float32x4_t y0 = linintfx4(fr,
+                                     float32x4(wt_saw_lut_f[i0[0]], wt_saw_lut_f[i0[1]], wt_saw_lut_f[i0[2]], wt_saw_lut_f[i0[3]]),
+                                     float32x4(wt_saw_lut_f[i1[0]], wt_saw_lut_f[i1[1]], wt_saw_lut_f[i1[2]], wt_saw_lut_f[i1[3]]));
+    const float32x4_t y1 = linintfx4(fr,
+                                     float32x4(wt_saw_lut_f[i0[0] + n[0]], wt_saw_lut_f[i0[1] + n[1]], wt_saw_lut_f[i0[2] + n[2]], wt_saw_lut_f[i0[3] + n[3]]),
+                                     float32x4(wt_saw_lut_f[i1[0] + n[0]], wt_saw_lut_f[i1[1] + n[1]], wt_saw_lut_f[i1[2] + n[2]], wt_saw_lut_f[i1[3] + n[3]]));
+    const float32x4_t y = linintfx4(idx_fr, y0, y1);
+    return float32x4_sel(second, float32x4_neg(y), y);
+  }
+
+  /**
+   * Sawtooth wave lookup for four phases
+   *
+   * @param x  Phase ratio per lane.
+   * @return   Wave sample per lane.
+   */
+  static fast_inline float32x4_t osc_sawfx4(float32x4_t x) 
+  {
+    return osc_bl2_sawfx4(x, f32x4_dup(0.f));
+  }
+
+  /**
+   * Scan one wave per lane, e.g.: one per voice
+   *
+   * @param w  Wave of k_waves_size samples for each lane.
+   * @param x  Phase ratio per lane.
+   * @return   Linearly interpolated wave sample per lane.
+   */
+  static fast_inline float32x4_t osc_wave_scanfx4(const float * const w[4], float32x4_t x) 
+  {
+    const float32x4_t p = float32x4_sub(x, si_u32x4_to_f32x4(si_f32x4_to_u32x4(x)));
+    const float32x4_t x0f = float32x4_mulscal(p, k_waves_size);
+    const uint32x4_t x0p = si_f32x4_to_u32x4(x0f);
+    const float32x4_t fr = float32x4_sub(x0f, si_u32x4_to_f32x4(x0p));
+
+    // no gather load on NEON, lanes are fetched one by one
+    uint32_t x0[4], x1[4];
+    const uint32x4_t x0m = uint32x4_and(x0p, u32x4_dup(k_waves_mask));
+    u32x4_str(x0, x0m);
+    u32x4_str(x1, uint32x4_and(uint32x4_add(x0m, u32x4_dup(1)), u32x4_dup(k_waves_mask)));
+
+    const float32x4_t y0 = float32x4(w[0][x0[0]], w[1][x0[1]], w[2][x0[2]], w[3][x0[3]]);
+    const float32x4_t y1 = float32x4(w[0][x1[0]], w[1][x1[1]], w[2][x1[2]], w[3][x1[3]]);
+    return linintfx4(fr, y0, y1);
+  }
+
 //** @} */
 
 #endif // __oscillator_api_h
@@ -0,0 +1,174 @@
+/**
+ * @file    mod_matrix.h
+ * @brief   Compiled modulation matrix for kMk2PlatformExclusiveModData
+ *
+ * @addtogroup utils Utils
+ * @{
+ *
+ * @addtogroup utils_mk2_mod_matrix Mod Matrix
+ * @{
+ *
+ * Each kMk2PlatformExclusiveModData message carries the destination index and
+ * depth of every mod source, followed by the source values per voice. The
+ * routing rarely changes between messages, so ModMatrix compiles it into a
+ * plan sorted by destination, holding only the sources routed to a unit
+ * destination with a non zero depth. The plan is rebuilt when the index,
+ * depth or voice count of a message differs from the last one.
+ *
+ * Applying a message then writes every routed destination once per quad of
+ * voices: the first source is multiplied by its depth and the others are
+ * accumulated on top, without clearing buffers or writing unassigned sources
+ * anywhere. Destinations without a route are cleared when the plan is
+ * rebuilt and left untouched afterwards.
+ */
+
+#ifndef __mod_matrix_h
+#define __mod_matrix_h
+
+#include <cstring>
+
+#include "runtime.h"
+#include "utils/buffer_ops.h"
+#include "utils/float_math.h"
+#include "utils/float_simd.h"
+#include "utils/mk2_utils.h"
+
+template <int NumDest>
+class ModMatrix
+{
+public:
+  ModMatrix():
+  mNumDests(0),
+  mVoiceLimit(0),
+  mValid(false)
+  {
+    for (int i = 0; i < NumDest; i++)
+    {
+      mBuffers[i] = nullptr;
+      mCurves[i] = nullptr;
+      mCurveSizes[i] = 0;
+    }
+  }
+
+  // buffer holds kMk2MaxVoices values, nullptr leaves the destination unused
+  void SetDestination(int dest, float * buffer)
+  {
+    mBuffers[dest] = buffer;
+    mValid = false;
+  }
+
+  // maps the absolute depth of the sources routed to dest through a table of
+  // size points spanning 0 ~ 1, for destinations with a very wide range
+  void SetDepthCurve(int dest, const float * table, uint32_t size)
+  {
+    mCurves[dest] = table;
+    mCurveSizes[dest] = size;
+    mValid = false;
+  }
+
+  // forces the next message to rebuild the plan and clear the destinations
+  void Invalidate() { mValid = false; }
+
+  // applies a kMk2PlatformExclusiveModData message
+  void Process(void * data, int voiceLimit)
+  {
+    const int32_t * index = GetModIndex(data);
+    const float * depth = GetModDepth(data);
+
+    if (!mValid
+        || voiceLimit != mVoiceLimit
+        || memcmp(index, mIndex, sizeof(mIndex)) != 0
+        || memcmp(depth, mDepth, sizeof(mDepth)) != 0)
+      Compile(index, depth, voiceLimit);
+
+    for (int d = 0; d < mNumDests; d++)
+    {
+      const Dest & dest = mDests[d];
+      for (int voice = 0; voice < voiceLimit; voice += 4)
+      {
+        float32x4_t value = float32x4_mulscal(f32x4_ld(GetModSourceData(data, mSources[dest.begin], voiceLimit, voice)), mGains[dest.begin]);
+        for (int r = dest.begin + 1; r < dest.end; r++)
+          value = float32x4_fmulscaladd(value, f32x4_ld(GetModSourceData(data, mSources[r], voiceLimit, voice)), mGains[r]);
+        f32x4_str(&dest.buffer[voice], value);
+      }
+    }
+  }
+
+private:
+  struct Dest
+  {
+    float * buffer;
+    int begin;
+    int end;
+  };
+
+  void Compile(const int32_t * index, const float * depth, int voiceLimit)
+  {
+    memcpy(mIndex, index, sizeof(mIndex));
+    memcpy(mDepth, depth, sizeof(mDepth));
+    mVoiceLimit = voiceLimit;
+    mValid = true;
+
+    int route = 0;
+    mNumDests = 0;
+    for (int d = 0; d < NumDest; d++)
+    {
+      if (mBuffers[d] == nullptr)
+        continue;
+
+      buf_clr_f32(mBuffers[d], kMk2MaxVoices);
+
+      const int begin = route;
+      for (int src = 0; src < kNumMk2ModSrc; src++)
+      {
+        const float gain = (index[src] == d) ? Gain(d, depth[src]) : 0.f;
+        if (gain == 0.f)
+          continue;
+        mSources[route] = src;
+        mGains[route] = gain;
+        route++;
+      }
+
+      if (route > begin)
+      {
+        mDests[mNumDests].buffer = mBuffers[d];
+        mDests[mNumDests].begin = begin;
+        mDests[mNumDests].end = route;
+        mNumDests++;
+      }
+    }
+  }
+
+  float Gain(int dest, float depth) const
+  {
+    if (mCurves[dest] == nullptr)
+      return depth;
+
+    const float * curve = mCurves[dest];
+    const float x = clip01f(si_fabsf(depth)) * (mCurveSizes[dest] - 1);
+    uint32_t i = static_cast<uint32_t>(x);
+    i = (i < mCurveSizes[dest] - 1) ? i : mCurveSizes[dest] - 2;
+    return linintf(x - i, curve[i], curve[i + 1]);
+  }
+
+  // routing the plan was compiled from
+  int32_t mIndex[kNumMk2ModSrc];
+  float mDepth[kNumMk2ModSrc];
+
+  // plan, routes sorted by destination
+  uint8_t mSources[kNumMk2ModSrc];
+  float mGains[kNumMk2ModSrc];
+  Dest mDests[NumDest];
+  int mNumDests;
+  int mVoiceLimit;
+  bool mValid;
+
+  float * mBuffers[NumDest];
+  const float * mCurves[NumDest];
+  uint32_t mCurveSizes[NumDest];
+};
+
+/** @} */
+/** @} */
+
+#endif // __mod_matrix_h
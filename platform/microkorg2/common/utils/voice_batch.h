@@ -0,0 +1,194 @@
+/**
+ * @file    voice_batch.h
+ * @brief   Lane count generic wrappers over the SIMD utilities
+ *
+ * @addtogroup utils Utils
+ * @{
+ *
+ * @addtogroup utils_mk2_voice_batch Voice Batch
+ * @{
+ *
+ * VoiceBatch<Lanes> maps one set of operations onto float, float32x2_t,
+ * float32x4_t and float32x4x2_t, so that a per-voice kernel can be written
+ * once as a template and instantiated for 1, 2, 4 or 8 voices. The 8 voice
+ * batch processes both quads in the same loop iteration rather than in two
+ * passes over the block.
+ *
+ * Buffers are interlaced with Lanes channels. Oscillator output is written in
+ * quads of voices, write_osc_output() places the second quad of an 8 voice
+ * batch at quadOffset from the first.
+ */
+
+#ifndef __voice_batch_h
+#define __voice_batch_h
+
+#include "utils/float_simd.h"
+#include "utils/int_simd.h"
+#include "utils/float_math.h"
+#include "utils/fixed_math.h"
+
+#define VOICE_BATCH_INLINE static inline __attribute__((optimize("Ofast"), always_inline))
+
+template <int Lanes> struct VoiceBatch;
+
+template <> struct VoiceBatch<1>
+{
+  typedef float f32;
+  typedef int32_t s32;
+  enum { kLanes = 1 };
+
+  VOICE_BATCH_INLINE f32 ld(const float * p) { return *p; }
+  VOICE_BATCH_INLINE void str(float * p, f32 x) { *p = x; }
+  VOICE_BATCH_INLINE f32 dup(float x) { return x; }
+  VOICE_BATCH_INLINE f32 add(f32 a, f32 b) { return a + b; }
+  VOICE_BATCH_INLINE f32 sub(f32 a, f32 b) { return a - b; }
+  VOICE_BATCH_INLINE f32 mul(f32 a, f32 b) { return a * b; }
+  VOICE_BATCH_INLINE f32 mulscal(f32 a, float s) { return a * s; }
+  VOICE_BATCH_INLINE f32 addscal(f32 a, float s) { return a + s; }
+  VOICE_BATCH_INLINE f32 fmuladd(f32 acc, f32 a, f32 b) { return acc + a * b; }
+  VOICE_BATCH_INLINE f32 fmulsub(f32 acc, f32 a, f32 b) { return acc - a * b; }
+  VOICE_BATCH_INLINE f32 fmulscaladd(f32 acc, f32 a, float s) { return acc + a * s; }
+  VOICE_BATCH_INLINE f32 clip01(f32 x) { return clip01f(x); }
+  VOICE_BATCH_INLINE f32 clip1m1(f32 x) { return clip1m1f(x); }
+
+  VOICE_BATCH_INLINE s32 lds(const int32_t * p) { return *p; }
+  VOICE_BATCH_INLINE void strs(int32_t * p, s32 x) { *p = x; }
+  VOICE_BATCH_INLINE s32 adds(s32 a, s32 b) { return (int32_t)((uint32_t)a + (uint32_t)b); }
+  VOICE_BATCH_INLINE s32 eors(s32 a, s32 b) { return a ^ b; }
+  VOICE_BATCH_INLINE f32 q31_to_float(s32 x) { return (float)x * q31_to_f32_c; }
+
+  VOICE_BATCH_INLINE f32 get_interlaced(const float * buffer, uint32_t index) { return buffer[index]; }
+  VOICE_BATCH_INLINE void put_interlaced(float * buffer, f32 x, uint32_t index) { buffer[index] = x; }
+
+  VOICE_BATCH_INLINE void write_osc_output(float * buffer, f32 x, uint32_t offset, uint32_t stride, uint32_t index,
+                                           uint32_t channel, uint32_t /*quadOffset*/)
+  {
+    buffer[offset + (index * stride) + (channel % 4)] = x;
+  }
+};
+
+template <> struct VoiceBatch<2>
+{
+  typedef float32x2_t f32;
+  typedef int32x2_t s32;
+  enum { kLanes = 2 };
+
+  VOICE_BATCH_INLINE f32 ld(const float * p) { return f32x2_ld(p); }
+  VOICE_BATCH_INLINE void str(float * p, f32 x) { f32x2_str(p, x); }
+  VOICE_BATCH_INLINE f32 dup(float x) { return f32x2_dup(x); }
+  VOICE_BATCH_INLINE f32 add(f32 a, f32 b) { return float32x2_add(a, b); }
+  VOICE_BATCH_INLINE f32 sub(f32 a, f32 b) { return float32x2_sub(a, b); }
+  VOICE_BATCH_INLINE f32 mul(f32 a, f32 b) { return float32x2_mul(a, b); }
+  VOICE_BATCH_INLINE f32 mulscal(f32 a, float s) { return float32x2_mulscal(a, s); }
+  VOICE_BATCH_INLINE f32 addscal(f32 a, float s) { return float32x2_addscal(a, s); }
+  VOICE_BATCH_INLINE f32 fmuladd(f32 acc, f32 a, f32 b) { return float32x2_fmuladd(acc, a, b); }
+  VOICE_BATCH_INLINE f32 fmulsub(f32 acc, f32 a, f32 b) { return float32x2_fmulsub(acc, a, b); }
+  VOICE_BATCH_INLINE f32 fmulscaladd(f32 acc, f32 a, float s) { return float32x2_fmulscaladd(acc, a, s); }
+  VOICE_BATCH_INLINE f32 clip01(f32 x) { return clip01fx2(x); }
+  VOICE_BATCH_INLINE f32 clip1m1(f32 x) { return clip1m1fx2(x); }
+
+  VOICE_BATCH_INLINE s32 lds(const int32_t * p) { return s32x2_ld(p); }
+  VOICE_BATCH_INLINE void strs(int32_t * p, s32 x) { s32x2_str(p, x); }
+  VOICE_BATCH_INLINE s32 adds(s32 a, s32 b) { return int32x2_add(a, b); }
+  VOICE_BATCH_INLINE s32 eors(s32 a, s32 b) { return veor_s32(a, b); }
+  VOICE_BATCH_INLINE f32 q31_to_float(s32 x) { return si_i32x2qn_to_f32x2(x, 31); }
+
+  VOICE_BATCH_INLINE f32 get_interlaced(const float * buffer, uint32_t index) { return f32x2_ld(&buffer[index * 2]); }
+  VOICE_BATCH_INLINE void put_interlaced(float * buffer, f32 x, uint32_t index) { f32x2_str(&buffer[index * 2], x); }
+
+  VOICE_BATCH_INLINE void write_osc_output(float * buffer, f32 x, uint32_t offset, uint32_t stride, uint32_t index,
+                                           uint32_t channel, uint32_t /*quadOffset*/)
+  {
+    f32x2_str(&buffer[offset + ((index * stride) + channel)], x);
+  }
+};
+
+template <> struct VoiceBatch<4>
+{
+  typedef float32x4_t f32;
+  typedef int32x4_t s32;
+  enum { kLanes = 4 };
+
+  VOICE_BATCH_INLINE f32 ld(const float * p) { return f32x4_ld(p); }
+  VOICE_BATCH_INLINE void str(float * p, f32 x) { f32x4_str(p, x); }
+  VOICE_BATCH_INLINE f32 dup(float x) { return f32x4_dup(x); }
+  VOICE_BATCH_INLINE f32 add(f32 a, f32 b) { return float32x4_add(a, b); }
+  VOICE_BATCH_INLINE f32 sub(f32 a, f32 b) { return float32x4_sub(a, b); }
+  VOICE_BATCH_INLINE f32 mul(f32 a, f32 b) { return float32x4_mul(a, b); }
+  VOICE_BATCH_INLINE f32 mulscal(f32 a, float s) { return float32x4_mulscal(a, s); }
+  VOICE_BATCH_INLINE f32 addscal(f32 a, float s) { return float32x4_addscal(a, s); }
+  VOICE_BATCH_INLINE f32 fmuladd(f32 acc, f32 a, f32 b) { return float32x4_fmuladd(acc, a, b); }
+  VOICE_BATCH_INLINE f32 fmulsub(f32 acc, f32 a, f32 b) { return float32x4_fmulsub(acc, a, b); }
+  VOICE_BATCH_INLINE f32 fmulscaladd(f32 acc, f32 a, float s) { return float32x4_fmulscaladd(acc, a, s); }
+  VOICE_BATCH_INLINE f32 clip01(f32 x) { return clip01fx4(x); }
+  VOICE_BATCH_INLINE f32 clip1m1(f32 x) { return clip1m1fx4(x); }
+
+  VOICE_BATCH_INLINE s32 lds(const int32_t * p) { return s32x4_ld(p); }
+  VOICE_BATCH_INLINE void strs(int32_t * p, s32 x) { s32x4_str(p, x); }
+  VOICE_BATCH_INLINE s32 adds(s32 a, s32 b) { return int32x4_add(a, b); }
+  VOICE_BATCH_INLINE s32 eors(s32 a, s32 b) { return veorq_s32(a, b); }
+  VOICE_BATCH_INLINE f32 q31_to_float(s32 x) { return si_i32x4qn_to_f32x4(x, 31); }
+
+  VOICE_BATCH_INLINE f32 get_interlaced(const float * buffer, uint32_t index) { return f32x4_ld(&buffer[index * 4]); }
+  VOICE_BATCH_INLINE void put_interlaced(float * buffer, f32 x, uint32_t index) { f32x4_str(&buffer[index * 4], x); }
+
+  VOICE_BATCH_INLINE void write_osc_output(float * buffer, f32 x, uint32_t offset, uint32_t stride, uint32_t index,
+                                           uint32_t /*channel*/, uint32_t /*quadOffset*/)
+  {
+    f32x4_str(&buffer[offset + (index * stride)], x);
+  }
+};
+
+template <> struct VoiceBatch<8>
+{
+  typedef float32x4x2_t f32;
+  typedef int32x4x2_t s32;
+  typedef VoiceBatch<4> Quad;
+  enum { kLanes = 8 };
+
+  VOICE_BATCH_INLINE f32 ld(const float * p) { return float32x4x2(f32x4_ld(p), f32x4_ld(p + 4)); }
+  VOICE_BATCH_INLINE void str(float * p, f32 x) { f32x4_str(p, x.val[0]); f32x4_str(p + 4, x.val[1]); }
+  VOICE_BATCH_INLINE f32 dup(float x) { return float32x4x2(f32x4_dup(x), f32x4_dup(x)); }
+  VOICE_BATCH_INLINE f32 add(f32 a, f32 b) { return float32x4x2(Quad::add(a.val[0], b.val[0]), Quad::add(a.val[1], b.val[1])); }
+  VOICE_BATCH_INLINE f32 sub(f32 a, f32 b) { return float32x4x2(Quad::sub(a.val[0], b.val[0]), Quad::sub(a.val[1], b.val[1])); }
+  VOICE_BATCH_INLINE f32 mul(f32 a, f32 b) { return float32x4x2(Quad::mul(a.val[0], b.val[0]), Quad::mul(a.val[1], b.val[1])); }
+  VOICE_BATCH_INLINE f32 mulscal(f32 a, float s) { return float32x4x2(Quad::mulscal(a.val[0], s), Quad::mulscal(a.val[1], s)); }
+  VOICE_BATCH_INLINE f32 addscal(f32 a, float s) { return float32x4x2(Quad::addscal(a.val[0], s), Quad::addscal(a.val[1], s)); }
+  VOICE_BATCH_INLINE f32 fmuladd(f32 acc, f32 a, f32 b)
+  {
+    return float32x4x2(Quad::fmuladd(acc.val[0], a.val[0], b.val[0]), Quad::fmuladd(acc.val[1], a.val[1], b.val[1]));
+  }
+  VOICE_BATCH_INLINE f32 fmulsub(f32 acc, f32 a, f32 b)
+  {
+    return float32x4x2(Quad::fmulsub(acc.val[0], a.val[0], b.val[0]), Quad::fmulsub(acc.val[1], a.val[1], b.val[1]));
+  }
+  VOICE_BATCH_INLINE f32 fmulscaladd(f32 acc, f32 a, float s)
+  {
+    return float32x4x2(Quad::fmulscaladd(acc.val[0], a.val[0], s), Quad::fmulscaladd(acc.val[1], a.val[1], s));
+  }
+  VOICE_BATCH_INLINE f32 clip01(f32 x) { return float32x4x2(clip01fx4(x.val[0]), clip01fx4(x.val[1])); }
+  VOICE_BATCH_INLINE f32 clip1m1(f32 x) { return float32x4x2(clip1m1fx4(x.val[0]), clip1m1fx4(x.val[1])); }
+
+  VOICE_BATCH_INLINE s32 lds(const int32_t * p) { s32 x = {{ s32x4_ld(p), s32x4_ld(p + 4) }}; return x; }
+  VOICE_BATCH_INLINE void strs(int32_t * p, s32 x) { s32x4_str(p, x.val[0]); s32x4_str(p + 4, x.val[1]); }
+  VOICE_BATCH_INLINE s32 adds(s32 a, s32 b) { s32 x = {{ int32x4_add(a.val[0], b.val[0]), int32x4_add(a.val[1], b.val[1]) }}; return x; }
+  VOICE_BATCH_INLINE s32 eors(s32 a, s32 b) { s32 x = {{ veorq_s32(a.val[0], b.val[0]), veorq_s32(a.val[1], b.val[1]) }}; return x; }
+  VOICE_BATCH_INLINE f32 q31_to_float(s32 x) { return float32x4x2(si_i32x4qn_to_f32x4(x.val[0], 31), si_i32x4qn_to_f32x4(x.val[1], 31)); }
+
+  VOICE_BATCH_INLINE f32 get_interlaced(const float * buffer, uint32_t index) { return ld(&buffer[index * 8]); }
+  VOICE_BATCH_INLINE void put_interlaced(float * buffer, f32 x, uint32_t index) { str(&buffer[index * 8], x); }
+
+  VOICE_BATCH_INLINE void write_osc_output(float * buffer, f32 x, uint32_t offset, uint32_t stride, uint32_t index,
+                                           uint32_t /*channel*/, uint32_t quadOffset)
+  {
+    f32x4_str(&buffer[offset + (index * stride)], x.val[0]);
+    f32x4_str(&buffer[offset + quadOffset + (index * stride)], x.val[1]);
+  }
+};
+
+#undef VOICE_BATCH_INLINE
+
+/** @} */
+/** @} */
+
+#endif // __voice_batch_h
@@ -15,7 +15,7 @@ CSRC = header.c
 
 # C++ sources that can be compiled in ARM or THUMB mode depending on the global
 # setting.
-CXXSRC = unit.cc
+CXXSRC = unit.cc dsp_check.cc
 
 # C sources to be compiled in ARM mode regardless of the global setting.
 # NOTE: Mixing ARM and THUMB mode enables the -mthumb-interwork compiler
@@ -0,0 +1,67 @@
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2025, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/*
+ *  File: dsp_check.cc
+ *
+ *  Explicit instantiations of the platform/common dsp libraries that no unit
+ *  uses yet. Building this unit compiles every member of them, so a change that
+ *  breaks one of these libraries fails here instead of in the first unit that
+ *  picks it up. The oscillator does not reference anything in this file, and
+ *  hidden visibility lets --gc-sections drop all of it from the unit.
+ *
+ */
+
+#include "dsp/Adaa.h"
+#include "dsp/BlepOscBank.h"
+#include "dsp/SineBank.h"
+#include "dsp/ModalBank.h"
+#include "dsp/EnvelopeBank.h"
+
+template class __attribute__((visibility("hidden"))) dsp::Adaa1<dsp::adaa::SoftClip>;
+template class __attribute__((visibility("hidden"))) dsp::Adaa1<dsp::adaa::Overdrive>;
+template class __attribute__((visibility("hidden"))) dsp::Adaa2<dsp::adaa::Tanh>;
+
+template class __attribute__((visibility("hidden"))) dsp::BlepOscBank<4>;
+template void dsp::BlepOscBank<4>::RenderX4<dsp::BlepOscBank<4>::kSaw>(int, float *, size_t);
+template void dsp::BlepOscBank<4>::RenderX4<dsp::BlepOscBank<4>::kPulse>(int, float *, size_t);
+template void dsp::BlepOscBank<4>::RenderX4<dsp::BlepOscBank<4>::kTriangle>(int, float *, size_t);
+template void dsp::BlepOscBank<4>::RenderX1<dsp::BlepOscBank<4>::kSaw>(int, float *, size_t);
+template void dsp::BlepOscBank<4>::RenderX1<dsp::BlepOscBank<4>::kPulse>(int, float *, size_t);
+template void dsp::BlepOscBank<4>::RenderX1<dsp::BlepOscBank<4>::kTriangle>(int, float *, size_t);
+
+template class __attribute__((visibility("hidden"))) dsp::SineBank<>;
+
+template class __attribute__((visibility("hidden"))) dsp::ModalBank<16>;
+
+template class __attribute__((visibility("hidden"))) dsp::EnvelopeBank<8>;
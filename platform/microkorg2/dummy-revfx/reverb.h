@@ -51,6 +51,7 @@
 #include "runtime.h"
 #include "unit_revfx.h"
 #include "macros.h"
+#include "dsp/TailTracker.h"
 
 class Reverb {
  public:
@@ -131,6 +132,10 @@ class Reverb {
     runtime_desc_ = *desc;
 
     buf_clr_u32(reinterpret_cast<uint32_t *>(params_), kNumParams);
+
+    // Note: set to the longest time the output can keep ringing after the input went silent,
+    //       update it from parameters if it depends on them (feedback, decay time...)
+    mTailTracker.SetTailLength(BUFFER_LENGTH >> 1);
     
     return k_unit_err_none;
   }
@@ -143,6 +148,7 @@ class Reverb {
 
   inline void Reset() {
     // Note: Reset effect state, excluding exposed parameter values.
+    mTailTracker.Reset();
   }
 
   inline void Resume() {
@@ -168,6 +174,15 @@ class Reverb {
     float * __restrict out_p = out;
     const float * out_e = out_p + (frames << 1);  // assuming stereo output
 
+    // Note: once input is silent and the effect tail has decayed, skip processing
+    //       and only write the dry signal. Delay memory is left untouched so that
+    //       processing resumes seamlessly when input comes back.
+    mTailTracker.ProcessInput(in, frames);
+    if (mTailTracker.IsIdle()) {
+      buf_cpy_f32(in, out, frames << 1);
+      return;
+    }
+
     for (; out_p != out_e; in_p += 2, out_p += 2) {
       // Process samples here
       
@@ -175,6 +190,8 @@ class Reverb {
       out_p[0] = in_p[0]; // left sample
       out_p[1] = in_p[1]; // right sample
     }
+
+    mTailTracker.ProcessOutput(out, frames);
   }
 
   inline void setParameter(uint8_t index, int32_t value) 
@@ -259,6 +276,8 @@ class Reverb {
   float mDepth;
 
   float * allocated_buffer_;
+
+  dsp::TailTracker mTailTracker;
   
   /*===========================================================================*/
   /* Private Methods. */
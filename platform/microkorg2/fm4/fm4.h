@@ -0,0 +1,592 @@
+#pragma once
+
+#include "unit_osc.h"
+#include "runtime.h"
+#include "utils/buffer_ops.h"
+#include "utils/mk2_utils.h"
+#include "utils/mod_matrix.h"
+#include "utils/float_simd.h"
+#include "utils/float_simd_approx.h"
+#include "utils/int_simd.h"
+#include "utils/io_ops.h"
+
+#ifndef fast_inline
+#define fast_inline __attribute__((optimize("Ofast"), always_inline)) inline
+#endif
+
+// Four operator FM (phase modulation) oscillator.
+// Operators run four voices at a time, one voice per float32x4_t lane, and use a
+// polynomial sine instead of a table lookup. Operator 4 has self feedback and the
+// eight algorithms are the classic 4-op ones, in which modulators always have a
+// higher number than the operators they modulate, so operators are computed from 4 down to 1.
+class Fm4
+{
+public:
+  /*===========================================================================*/
+  /* Lifecycle Methods. */
+  /*===========================================================================*/
+
+  Fm4(void)
+  {}
+
+  ~Fm4(void)
+  {}
+
+  inline int8_t Init(const unit_runtime_desc_t * desc)
+  {
+    // Note: make sure the unit is being loaded to the correct platform/module target
+    if (desc->target != unit_header.target)
+      return k_unit_err_target;
+
+    // Note: check API compatibility with the one this unit was built against
+    if (!UNIT_API_IS_COMPAT(desc->api))
+      return k_unit_err_api_version;
+
+    // Check compatibility of samplerate with unit, for microkorg2 should be 48000
+    if (desc->samplerate != 48000)
+      return k_unit_err_samplerate;
+
+    // Cache runtime descriptor to keep access to API hooks
+    runtime_desc_ = *desc;
+
+    for(int i = 0; i < kNumParams; i++)
+    {
+      mParameter[i] = unit_header.params[i].init;
+    }
+
+    buf_clr_f32(mIndexMod, kMk2MaxVoices);
+    buf_clr_f32(mFeedbackMod, kMk2MaxVoices);
+    buf_clr_f32(mPitchMod, kMk2MaxVoices);
+    buf_clr_f32(mLevelMod, kMk2MaxVoices);
+
+    mModMatrix.SetDestination(kModDestIndex, mIndexMod);
+    mModMatrix.SetDestination(kModDestFeedback, mFeedbackMod);
+    mModMatrix.SetDestination(kModDestPitch, mPitchMod);
+    mModMatrix.SetDestination(kModDestLevel, mLevelMod);
+
+    Reset();
+
+    return k_unit_err_none;
+  }
+
+  inline void Teardown()
+  {
+    // Note: cleanup and release resources if any
+  }
+
+  inline void Reset()
+  {
+    for(int op = 0; op < kNumOps; op++)
+    {
+      buf_clr_i32(mPhase[op], kMk2MaxVoices);
+      buf_clr_i32(mPhaseInc[op], kMk2MaxVoices);
+      buf_clr_f32(mGain[op], kMk2MaxVoices);
+      buf_clr_f32(mGainZ[op], kMk2MaxVoices);
+    }
+    buf_clr_f32(mFeedback, kMk2MaxVoices);
+    buf_clr_f32(mFeedbackZ1, kMk2MaxVoices);
+    buf_clr_f32(mFeedbackZ2, kMk2MaxVoices);
+    buf_clr_f32(mOscBuffer, kMk2HalfVoices * kMk2BufferSize);
+
+    for(int i = 0; i < kMk2MaxVoices; i++)
+    {
+      mModEnv[i] = 1.f;
+      mVelocity[i] = 1.f;
+    }
+  }
+
+  inline void Resume()
+  {
+    // Note: Synth will resume and exit suspend state. Usually means the synth
+    // was selected and the render callback will be called again
+    Reset();
+  }
+
+  inline void Suspend()
+  {
+    // Note: Synth will enter suspend state. Usually means another synth was
+    // selected and thus the render callback will not be called
+  }
+
+  /*===========================================================================*/
+  /* Other Public Methods. */
+  /*===========================================================================*/
+
+  fast_inline void Process(float * out, size_t frames)
+  {
+    const unit_runtime_osc_context_t * ctxt = static_cast<const unit_runtime_osc_context_t *>(runtime_desc_.hooks.runtime_context);
+    UpdateVoicePitch(ctxt->pitch);
+    UpdateModEnv(frames, ctxt);
+    UpdateGains();
+
+    switch (ctxt->voiceLimit)
+    {
+      case kMk2MaxVoices:
+      {
+        ProcessOscx4(ctxt, 0, out, frames);
+        ProcessOscx4(ctxt, 4, out, frames);
+        break;
+      }
+
+      case kMk2HalfVoices:
+      {
+        ProcessOscx4(ctxt, 0, out, frames);
+        break;
+      }
+
+      // fewer voices cost the same as four, only the used lanes are written out
+      case kMk2QuarterVoices:
+      {
+        ProcessOscx2(ctxt, 0, out, frames);
+        break;
+      }
+
+      case kMk2SingleVoice:
+      {
+        ProcessOscx1(ctxt, 0, out, frames);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  inline void setParameter(uint8_t index, int32_t value)
+  {
+    if (index >= kNumParams) return;
+
+    mParameter[index] = value;
+  }
+
+  inline int32_t getParameterValue(uint8_t index) const
+  {
+    if (index >= kNumParams) return 0;
+    return mParameter[index];
+  }
+
+  inline const char * getParameterStrValue(uint8_t index, int32_t value) const
+  {
+    switch (index)
+    {
+      case kParamAlgorithm:
+      {
+        static const char * algorithmNames[kNumAlgorithms] =
+        {
+          "4>3>2>1",
+          "3+4>2>1",
+          "3>2+4>1",
+          "4>3+2>1",
+          "4>3 2>1",
+          "4>1 2 3",
+          "4>3 1 2",
+          "1 2 3 4"
+        };
+        return (value >= 0 && value < kNumAlgorithms) ? algorithmNames[value] : nullptr;
+      }
+
+      default:
+        break;
+    }
+
+    return nullptr;
+  }
+
+  void platformExclusive(uint8_t messageId, void * data, uint32_t /*dataSize*/)
+  {
+    const unit_runtime_osc_context_t * ctxt = static_cast<const unit_runtime_osc_context_t *>(runtime_desc_.hooks.runtime_context);
+    switch (messageId)
+    {
+      case kMk2PlatformExclusiveModData:
+      {
+        mModMatrix.Process(data, ctxt->voiceLimit);
+        break;
+      }
+
+      case kMk2PlatformExclusiveModDestName:
+      {
+        static const char * modDestNames[kNumModDest] =
+        {
+          "Index",
+          "Feedback",
+          "Pitch",
+          "Level"
+        };
+
+        char * modName = GetModDestNameData(data);
+        const uint8_t modIndex = modName[0];
+        if(modIndex < kNumModDest)
+        {
+          for(int i = 0; modDestNames[modIndex][i] != '\0'; i++)
+          {
+            modName[i + 1] = modDestNames[modIndex][i];
+          }
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  void voiceEvent(uint8_t event, uint8_t voice, uint8_t /*note*/, uint8_t velocity)
+  {
+    switch (event)
+    {
+      case k_voice_event_steal:
+      case k_voice_event_allocation:
+      {
+        // restart operators in phase so every note has the same timbre
+        for(int op = 0; op < kNumOps; op++)
+        {
+          mPhase[op][voice] = 0;
+        }
+        mFeedbackZ1[voice] = 0.f;
+        mFeedbackZ2[voice] = 0.f;
+        mModEnv[voice] = 1.f;
+        mVelocity[voice] = velocity * (1.f / 127.f);
+        break;
+      }
+
+      case k_voice_event_release:
+      case k_voice_event_deallocation:
+      default:
+        break;
+    }
+  }
+
+ private:
+  /*===========================================================================*/
+  /* Private Member Variables. */
+  /*===========================================================================*/
+
+  enum
+  {
+    kParamAlgorithm,
+    kParamIndex,
+    kParamFeedback,
+    kParamRatio1,
+    kParamRatio2,
+    kParamRatio3,
+    kParamRatio4,
+    kParamModDecay,
+    kParamLevel1,
+    kParamLevel2,
+    kParamLevel3,
+    kParamLevel4,
+    kParamVelocity,
+    kNumParams
+  };
+
+  enum
+  {
+    kModDestIndex,
+    kModDestFeedback,
+    kModDestPitch,
+    kModDestLevel,
+    kNumModDest
+  };
+
+  enum
+  {
+    kNumOps = 4,
+    kNumAlgorithms = 8
+  };
+
+  // modulation routes, in the order 2>1, 3>1, 4>1, 3>2, 4>2, 4>3
+  enum
+  {
+    kRoute2To1,
+    kRoute3To1,
+    kRoute4To1,
+    kRoute3To2,
+    kRoute4To2,
+    kRoute4To3,
+    kNumRoutes
+  };
+
+  static constexpr float kMaxIndex = 2.f;         // peak phase deviation of a full level modulator, in cycles
+  static constexpr float kMaxFeedback = 0.25f;    // in cycles
+  static constexpr float kPitchModRange = 24.f;   // semitones
+  static constexpr float kMaxW0 = 0.49f;
+
+  unit_runtime_desc_t runtime_desc_;
+
+  int32_t mPhase[kNumOps][kMk2MaxVoices];
+  int32_t mPhaseInc[kNumOps][kMk2MaxVoices];
+  float mGain[kNumOps][kMk2MaxVoices];
+  float mGainZ[kNumOps][kMk2MaxVoices];
+  float mFeedback[kMk2MaxVoices];
+  float mFeedbackZ1[kMk2MaxVoices];
+  float mFeedbackZ2[kMk2MaxVoices];
+  float mModEnv[kMk2MaxVoices];
+  float mVelocity[kMk2MaxVoices];
+  float mOscBuffer[kMk2HalfVoices * kMk2BufferSize]; // max voices to process at one time is 4
+
+  // mod
+  ModMatrix<kNumModDest> mModMatrix;
+  float mIndexMod[kMk2MaxVoices];
+  float mFeedbackMod[kMk2MaxVoices];
+  float mPitchMod[kMk2MaxVoices];
+  float mLevelMod[kMk2MaxVoices];
+
+  int32_t mParameter[kNumParams];
+
+  /*===========================================================================*/
+  /* Private Methods. */
+  /*===========================================================================*/
+
+  static const float * GetRoutes(int algorithm)
+  {
+    static const float routes[kNumAlgorithms][kNumRoutes] =
+    {
+      // 2>1 3>1 4>1 3>2 4>2 4>3
+      {1.f, 0.f, 0.f, 1.f, 0.f, 1.f},
+      {1.f, 0.f, 0.f, 1.f, 1.f, 0.f},
+      {1.f, 0.f, 1.f, 1.f, 0.f, 0.f},
+      {1.f, 1.f, 0.f, 0.f, 0.f, 1.f},
+      {1.f, 0.f, 0.f, 0.f, 0.f, 1.f},
+      {0.f, 0.f, 1.f, 0.f, 1.f, 1.f},
+      {0.f, 0.f, 0.f, 0.f, 0.f, 1.f},
+      {0.f, 0.f, 0.f, 0.f, 0.f, 0.f}
+    };
+    return routes[algorithm];
+  }
+
+  static const float * GetCarriers(int algorithm)
+  {
+    static const float carriers[kNumAlgorithms][kNumOps] =
+    {
+      {1.f, 0.f, 0.f, 0.f},
+      {1.f, 0.f, 0.f, 0.f},
+      {1.f, 0.f, 0.f, 0.f},
+      {1.f, 0.f, 0.f, 0.f},
+      {1.f, 0.f, 1.f, 0.f},
+      {1.f, 1.f, 1.f, 0.f},
+      {1.f, 1.f, 1.f, 0.f},
+      {1.f, 1.f, 1.f, 1.f}
+    };
+    return carriers[algorithm];
+  }
+
+  fast_inline int GetAlgorithm() const
+  {
+    return clipminmaxi32(0, mParameter[kParamAlgorithm], kNumAlgorithms - 1);
+  }
+
+  void UpdateVoicePitch(const float * noteNumber)
+  {
+    const float frequencyMultiplier = 0x7FFFFFFF;
+
+    float ratio[kNumOps];
+    for(int op = 0; op < kNumOps; op++)
+    {
+      ratio[op] = mParameter[kParamRatio1 + op] * 0.1f;
+    }
+
+    // always calc 8 for simplicity, the pitch array holds all voices
+    for(int i = 0; i < kMk2MaxVoices; i+=4)
+    {
+      float32x4_t note = float32x4_fmulscaladd(f32x4_ld(&noteNumber[i]), f32x4_ld(&mPitchMod[i]), kPitchModRange);
+      note = clipminmaxfx4(f32x4_dup(0.f), note, f32x4_dup(k_midi_to_hz_size - 2));
+      uint32x4_t noteWhole = si_f32x4_to_u32x4(note);
+      float32x4_t frequency = osc_w0f_for_notex4(noteWhole, float32x4_sub(note, si_u32x4_to_f32x4(noteWhole)));
+      for(int op = 0; op < kNumOps; op++)
+      {
+        float32x4_t w0 = clipmaxfx4(float32x4_mulscal(frequency, ratio[op]), f32x4_dup(kMaxW0));
+        s32x4_str(&mPhaseInc[op][i], int32x4_mulscal(si_f32x4_to_i32x4(float32x4_mulscal(w0, frequencyMultiplier)), 2));
+      }
+    }
+  }
+
+  // modulator envelope, decays from note on at block rate and doubles as the unit's mod source
+  void UpdateModEnv(int frames, const unit_runtime_osc_context_t * context)
+  {
+    const float decay = mParameter[kParamModDecay] * 0.01f;
+    const float decayTime = 0.01f * fasterpowf(500.f, decay); // 10 ms ~ 5 s
+    const float coeff = (decay == 0.f) ? 1.f : fasterexpf(-frames / (decayTime * runtime_desc_.samplerate));
+    for(int i = 0; i < kMk2MaxVoices; i+=4)
+    {
+      f32x4_str(&mModEnv[i], float32x4_mulscal(f32x4_ld(&mModEnv[i]), coeff));
+    }
+
+    switch (context->voiceLimit)
+    {
+      case kMk2MaxVoices:
+      {
+        for(int i = 0; i < kMk2MaxVoices; i+=4)
+        {
+          WriteUnitModDatax4(context, float32x4_fmulscaladd(f32x4_dup(-1.f), f32x4_ld(&mModEnv[i]), 2.f), i);
+        }
+        break;
+      }
+
+      case kMk2HalfVoices:
+      {
+        WriteUnitModDatax4(context, float32x4_fmulscaladd(f32x4_dup(-1.f), f32x4_ld(&mModEnv[0]), 2.f), 0);
+        break;
+      }
+
+      case kMk2QuarterVoices:
+      {
+        WriteUnitModDatax2(context, float32x2_fmulscaladd(f32x2_dup(-1.f), f32x2_ld(&mModEnv[0]), 2.f), 0);
+        break;
+      }
+
+      case kMk2SingleVoice:
+      {
+        WriteUnitModDatax1(context, mModEnv[0] * 2.f - 1.f, 0);
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+
+  // operator output gains, modulation index for modulators and output level for carriers
+  void UpdateGains()
+  {
+    const float * carriers = GetCarriers(GetAlgorithm());
+    float numCarriers = 0.f;
+    for(int op = 0; op < kNumOps; op++)
+    {
+      numCarriers += carriers[op];
+    }
+    const float carrierNorm = 1.f / numCarriers;
+
+    const float index = mParameter[kParamIndex] * 0.01f;
+    const float feedback = mParameter[kParamFeedback] * 0.01f;
+    const float velocitySens = mParameter[kParamVelocity] * 0.01f;
+
+    for(int i = 0; i < kMk2MaxVoices; i+=4)
+    {
+      // velocity only scales the modulators, so it brightens rather than gets louder
+      const float32x4_t velocity = float32x4_fmulscaladd(f32x4_dup(1.f - velocitySens), f32x4_ld(&mVelocity[i]), velocitySens);
+      float32x4_t modGain = clipminmaxfx4(f32x4_dup(0.f), float32x4_add(f32x4_dup(index), f32x4_ld(&mIndexMod[i])), f32x4_dup(1.f));
+      modGain = float32x4_mul(float32x4_mul(modGain, f32x4_ld(&mModEnv[i])), float32x4_mulscal(velocity, kMaxIndex));
+      const float32x4_t carrierGain = clipminmaxfx4(f32x4_dup(0.f), float32x4_addscal(f32x4_ld(&mLevelMod[i]), 1.f), f32x4_dup(1.f));
+
+      for(int op = 0; op < kNumOps; op++)
+      {
+        const float level = mParameter[kParamLevel1 + op] * 0.01f;
+        const float32x4_t gain = (carriers[op] > 0.f) ? float32x4_mulscal(carrierGain, level * carrierNorm) : float32x4_mulscal(modGain, level);
+        f32x4_str(&mGain[op][i], gain);
+      }
+
+      const float32x4_t fb = clipminmaxfx4(f32x4_dup(0.f), float32x4_add(f32x4_dup(feedback), f32x4_ld(&mFeedbackMod[i])), f32x4_dup(1.f));
+      f32x4_str(&mFeedback[i], float32x4_mulscal(fb, kMaxFeedback));
+    }
+  }
+
+  void ProcessOscx4(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
+  {
+    GenerateX4(voiceNum, frames);
+
+    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
+    for(uint32_t i = 0; i < frames; i++)
+    {
+      write_oscillator_output_x4(out, get_interlaced_samplef32x4(mOscBuffer, i, 0, 4), offset, ctxt->outputStride, i);
+    }
+  }
+
+  void ProcessOscx2(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
+  {
+    GenerateX4(voiceNum, frames);
+
+    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
+    for(uint32_t i = 0; i < frames; i++)
+    {
+      write_oscillator_output_x2(out, get_interlaced_samplef32x2(mOscBuffer, i, 0, 4), offset, ctxt->outputStride, i, ctxt->voiceOffset);
+    }
+  }
+
+  void ProcessOscx1(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
+  {
+    GenerateX4(voiceNum, frames);
+
+    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
+    for(uint32_t i = 0; i < frames; i++)
+    {
+      write_oscillator_output_x1(out, get_interlaced_sample(mOscBuffer, i, 0, 4), offset, ctxt->outputStride, i, ctxt->voiceOffset);
+    }
+  }
+
+  // phase in q31 half cycles, mod in cycles within +/-128
+  static fast_inline float32x4_t OperatorX4(int32x4_t phase, float32x4_t mod)
+  {
+    const int32x4_t offset = int32x4_shlscal(si_f32x4_to_i32x4(float32x4_mulscal(mod, 16777216.f)), 8);
+    return fastsinpifx4(si_i32x4qn_to_f32x4(int32x4_add(phase, offset), 31));
+  }
+
+  void GenerateX4(const uint32_t voiceNum, const uint32_t frames)
+  {
+    const float * routes = GetRoutes(GetAlgorithm());
+    const float * carriers = GetCarriers(GetAlgorithm());
+
+    const float invFrames = 1.f / float(frames);
+    int32x4_t phase[kNumOps];
+    int32x4_t inc[kNumOps];
+    float32x4_t gain[kNumOps];
+    float32x4_t gainDelta[kNumOps];
+    for(int op = 0; op < kNumOps; op++)
+    {
+      phase[op] = s32x4_ld(&mPhase[op][voiceNum]);
+      inc[op] = s32x4_ld(&mPhaseInc[op][voiceNum]);
+      gain[op] = f32x4_ld(&mGainZ[op][voiceNum]);
+      gainDelta[op] = float32x4_mulscal(float32x4_sub(f32x4_ld(&mGain[op][voiceNum]), gain[op]), invFrames);
+    }
+
+    // feedback from the mean of the last two outputs of operator 4 keeps it from oscillating at high amounts
+    const float32x4_t feedback = float32x4_mulscal(f32x4_ld(&mFeedback[voiceNum]), 0.5f);
+    float32x4_t fbZ1 = f32x4_ld(&mFeedbackZ1[voiceNum]);
+    float32x4_t fbZ2 = f32x4_ld(&mFeedbackZ2[voiceNum]);
+
+    for(uint32_t i = 0; i < frames; i++)
+    {
+      for(int op = 0; op < kNumOps; op++)
+      {
+        gain[op] = float32x4_add(gain[op], gainDelta[op]);
+      }
+
+      const float32x4_t s4 = OperatorX4(phase[3], float32x4_mul(float32x4_add(fbZ1, fbZ2), feedback));
+      fbZ2 = fbZ1;
+      fbZ1 = s4;
+      const float32x4_t op4 = float32x4_mul(s4, gain[3]);
+
+      const float32x4_t mod3 = float32x4_mulscal(op4, routes[kRoute4To3]);
+      const float32x4_t op3 = float32x4_mul(OperatorX4(phase[2], mod3), gain[2]);
+
+      float32x4_t mod2 = float32x4_mulscal(op3, routes[kRoute3To2]);
+      mod2 = float32x4_fmulscaladd(mod2, op4, routes[kRoute4To2]);
+      const float32x4_t op2 = float32x4_mul(OperatorX4(phase[1], mod2), gain[1]);
+
+      float32x4_t mod1 = float32x4_mulscal(op2, routes[kRoute2To1]);
+      mod1 = float32x4_fmulscaladd(mod1, op3, routes[kRoute3To1]);
+      mod1 = float32x4_fmulscaladd(mod1, op4, routes[kRoute4To1]);
+      const float32x4_t op1 = float32x4_mul(OperatorX4(phase[0], mod1), gain[0]);
+
+      float32x4_t output = float32x4_mulscal(op1, carriers[0]);
+      output = float32x4_fmulscaladd(output, op2, carriers[1]);
+      output = float32x4_fmulscaladd(output, op3, carriers[2]);
+      output = float32x4_fmulscaladd(output, op4, carriers[3]);
+      write_to_interlaced_bufferf32x4(mOscBuffer, output, i, 0, 4);
+
+      for(int op = 0; op < kNumOps; op++)
+      {
+        phase[op] = int32x4_add(phase[op], inc[op]);
+      }
+    }
+
+    for(int op = 0; op < kNumOps; op++)
+    {
+      s32x4_str(&mPhase[op][voiceNum], phase[op]);
+      buf_cpy_f32(&mGain[op][voiceNum], &mGainZ[op][voiceNum], 4);
+    }
+    f32x4_str(&mFeedbackZ1[voiceNum], fbZ1);
+    f32x4_str(&mFeedbackZ2[voiceNum], fbZ2);
+  }
+
+  /*===========================================================================*/
+  /* Constants. */
+  /*===========================================================================*/
+};
@@ -9,6 +9,7 @@
 #include "utils/float_simd.h"
 #include "utils/io_ops.h"
 #include "utils/fixed_math.h"
+#include "utils/mod_matrix.h"
 #include "dsp/mk2_biquad.hpp"
 #include <string>
 #include <unistd.h>
@@ -92,6 +93,17 @@ public:
 
     buf_clr_i32(mPhase, kMk2MaxVoices);
     buf_clr_i32(mPhaseInc, kMk2MaxVoices);
+    // voices may already be gated when the unit loads, they are culled once deallocated
+    mActiveVoices = (1u << kMk2MaxVoices) - 1;
+
+    mModMatrix.SetDestination(kModDestSyllable, mSyllableMod);
+    mModMatrix.SetDestination(kModDestFormant, mFormantMod);
+    mModMatrix.SetDestination(kModDestResonance, mResoMod);
+    mModMatrix.SetDestination(kModDestShape, mShapeMod);
+    mModMatrix.SetDestination(kModDestPitch, mPitchMod);
+    mModMatrix.SetDestination(kModDestNoise, mNoiseLevelMod);
+    // Pitch mod range is very wide, so apply curve to make this parameter more useful.
+    mModMatrix.SetDepthCurve(kModDestPitch, mPitchModDepthCurve, PitchModDepthCurveTableSize);
 
     for(int i = 0; i < kNumParams; i++)
     {
@@ -115,7 +127,7 @@ public:
     buf_clr_f32(mPitchMod, kMk2MaxVoices);
     buf_clr_f32(mNoiseLevelMod, kMk2MaxVoices);
     buf_clr_f32(mSawZ, kMk2MaxVoices);
-    buf_clr_f32(mOscBuffer, kMk2HalfVoices * kMk2BufferSize);
+    buf_clr_f32(mOscBuffer, kMk2MaxVoices * kMk2BufferSize);
     
     // jump smoothing to target value
     buf_cpy_f32(mShape, mShapeZ, kMk2MaxVoices);
@@ -134,6 +146,9 @@ public:
     mFormantFilter2.flush();
     mFormantFilter3.flush();
 
+    // allocations made while suspended were not seen, render every voice until deallocated
+    mActiveVoices = (1u << kMk2MaxVoices) - 1;
+
     // set starting seeds 
     // (generated by arbitrarily advancing seed suggested in comments of https://www.musicdsp.org/en/latest/Synthesis/216-fast-whitenoise-generator.html)
     mNoiseX1[0] = 0x70f4f854;
@@ -184,26 +199,25 @@ public:
     {
       case kMk2MaxVoices:
       {
-        ProcessOscx4(ctxt, 0, out, frames);
-        ProcessOscx4(ctxt, 4, out, frames);
+        ProcessOsc<kMk2MaxVoices>(ctxt, 0, out, frames);
         break;
       }
     
       case kMk2HalfVoices:
       {
-        ProcessOscx4(ctxt, 0, out, frames);
+        ProcessOsc<kMk2HalfVoices>(ctxt, 0, out, frames);
         break;
       }
 
       case kMk2QuarterVoices:
       {
-        ProcessOscx2(ctxt, 0, out, frames);
+        ProcessOsc<kMk2QuarterVoices>(ctxt, 0, out, frames);
         break;
       }
 
       case kMk2SingleVoice:
       {
-        ProcessOscx1(ctxt, 0, out, frames);
+        ProcessOsc<kMk2SingleVoice>(ctxt, 0, out, frames);
         break;
       }
       default:
@@ -364,46 +378,17 @@ public:
     switch (context->voiceLimit)
     {
       case kMk2MaxVoices:
-      {
-        for(int i = 0; i < kMk2MaxVoices/4; i++)
-        {
-          const int idx = i * 4;
-          float32x4_t mod = f32x4_ld(&modOutput[idx]);
-          WriteUnitModDataPlusx4(context, mod, idx);
-
-          mod = float32x4_fmuladd(f32x4_dup(-1.f), mod, f32x4_dup(2.f));
-          WriteUnitModDataPlusMinusx4(context, mod, idx);
-        }
+        WriteEgMod<kMk2MaxVoices>(context, modOutput);
         break;
-      }
-    
       case kMk2HalfVoices:
-      {
-        float32x4_t mod = f32x4_ld(&modOutput[0]);
-        WriteUnitModDataPlusx4(context, mod, 0);
-
-        mod = float32x4_fmuladd(f32x4_dup(-1.f), mod, f32x4_dup(2.f));
-        WriteUnitModDataPlusMinusx4(context, mod, 0);
+        WriteEgMod<kMk2HalfVoices>(context, modOutput);
         break;
-      }
-
       case kMk2QuarterVoices:
-      {
-        float32x2_t mod = f32x2_ld(&modOutput[0]);
-        WriteUnitModDataPlusx2(context, mod, 0);
-        
-        mod = float32x2_fmuladd(f32x2_dup(-1.f), mod, f32x2_dup(2.f));
-        WriteUnitModDataPlusMinusx2(context, mod, 0);
+        WriteEgMod<kMk2QuarterVoices>(context, modOutput);
         break;
-      }
-
       case kMk2SingleVoice:
-      {
-        WriteUnitModDataPlusx1(context, modOutput[0], 0);
-        WriteUnitModDataPlusMinusx1(context, modOutput[0] * 2.f - 1.f, 0);
+        WriteEgMod<kMk2SingleVoice>(context, modOutput);
         break;
-      }
-    
       default:
         break;
     }
@@ -455,6 +440,17 @@ public:
     }
   }
 
+  template <int Lanes>
+  void WriteEgMod(const unit_runtime_osc_context_t * context, const float * modOutput)
+  {
+    typedef VoiceBatch<Lanes> B;
+    typename B::f32 mod = B::ld(modOutput);
+    WriteUnitModDataPlus<Lanes>(context, mod, 0);
+
+    mod = B::fmuladd(B::dup(-1.f), mod, B::dup(2.f));
+    WriteUnitModDataPlusMinus<Lanes>(context, mod, 0);
+  }
+
   void platformExclusive(uint8_t messageId, void * data, uint32_t /*dataSize*/) 
   {
     const unit_runtime_osc_context_t * ctxt = static_cast<const unit_runtime_osc_context_t *>(runtime_desc_.hooks.runtime_context);
@@ -462,67 +458,7 @@ public:
     {
       case kMk2PlatformExclusiveModData:
       {
-        float * modDepth = GetModDepth(data);
-        int32_t * index = GetModIndex(data);
-
-        // clear old data
-        buf_clr_f32(mSyllableMod, kMk2MaxVoices);
-        buf_clr_f32(mFormantMod, kMk2MaxVoices);
-        buf_clr_f32(mResoMod, kMk2MaxVoices);
-        buf_clr_f32(mShapeMod, kMk2MaxVoices);
-        buf_clr_f32(mPitchMod, kMk2MaxVoices);
-        buf_clr_f32(mNoiseLevelMod, kMk2MaxVoices);
-
-        // generate array of destinations
-        float * destinationBuffers[kNumModDest] = 
-        {
-          mSyllableMod,
-          mFormantMod,
-          mResoMod,
-          mShapeMod,
-          mPitchMod,
-          mNoiseLevelMod
-        };
-
-        float * dests[kNumMk2ModSrc];
-        for(int i = 0; i < kNumMk2ModSrc; i++)
-        {
-          // using a dummy buffer (mNoAssign) here allows us to vectorize the later calculations
-          // without worrying about nullptrs or applying unwanted modulation to parameters
-          dests[i] = (index[i] < kNumModDest) ? destinationBuffers[index[i]] : mNoAssign;
-        }
-
-        float depths[kNumMk2ModSrc];
-        const float pitchTableRange = float(PitchModDepthCurveTableSize - 1);
-        for(int i = 0; i < kNumMk2ModSrc; i++)
-        {
-          if(index[i] == kModDestPitch)
-          {
-            // Pitch mod range is very wide, so apply curve to make this parameter more useful.
-            const float pitchModDepthParam = si_fabsf(modDepth[i]) * pitchTableRange;
-            const uint32_t pitchModDepthIndex = static_cast<uint32_t>(pitchModDepthParam);
-            const float pitchModDepth = linintf(pitchModDepthParam - pitchModDepthIndex, 
-                                                mPitchModDepthCurve[pitchModDepthIndex], 
-                                                mPitchModDepthCurve[pitchModDepthIndex + 1]);
-            depths[i] = pitchModDepth;
-          }
-          else
-          {
-            depths[i] = modDepth[i];
-          }
-        }
-
-        for(int voice = 0; voice < ctxt->voiceLimit; voice+=4)
-        {
-          for(int modDest = 0; modDest < kNumMk2ModSrc; modDest++)
-          {
-            float * curr = dests[modDest];
-            float32x4_t currentValue = f32x4_ld(&curr[voice]);
-            float * modData = GetModSourceData(data, modDest, ctxt->voiceLimit, voice);
-            currentValue = float32x4_fmulscaladd(currentValue, f32x4_ld(modData), depths[modDest]);
-            f32x4_str(&curr[voice], currentValue);
-          }
-        }
+        mModMatrix.Process(data, ctxt->voiceLimit);
         break;
       }
     
@@ -616,6 +552,10 @@ public:
         mEgOffset[voice] = 0;
         mEgPhase[voice] = 0;
         mEgState[voice] = kEgStateAttack;
+        if(!(mActiveVoices & (1u << voice)))
+        {
+          WakeVoice(voice);
+        }
         break;
       }
 
@@ -631,6 +571,11 @@ public:
       }
 
       case k_voice_event_deallocation:
+      {
+        mActiveVoices &= ~(1u << voice);
+        break;
+      }
+
       default:
         break;
     }
@@ -694,7 +639,7 @@ public:
   int32_t mNoiseX1[kMk2MaxVoices];
   int32_t mNoiseX2[kMk2MaxVoices];
   float mSawZ[kMk2MaxVoices];
-  float mOscBuffer[kMk2HalfVoices * kMk2BufferSize]; // max voices to process at one time is 4
+  float mOscBuffer[kMk2MaxVoices * kMk2BufferSize]; // max voices to process at one time is 8
 
   // param
   float mDpwGainCompensation[kMk2MaxVoices];
@@ -706,7 +651,7 @@ public:
   float mWaveLevelZ[kMk2MaxVoices];
 
   // mod
-  float mNoAssign[kMk2MaxVoices];
+  ModMatrix<kNumModDest> mModMatrix;
   float mSyllableMod[kMk2MaxVoices];
   float mFormantMod[kMk2MaxVoices];
   float mResoMod[kMk2MaxVoices];
@@ -723,6 +668,9 @@ public:
   int32_t mEgReleaseCoeff;
   int32_t mEgHoldCoeff;
 
+  // bit per voice, set from allocation (and on init/reset) until the platform deallocates it
+  uint32_t mActiveVoices;
+
   enum { PitchModDepthCurveTableSize = 65 };
   const float mPitchModDepthCurve[PitchModDepthCurveTableSize];
   const float mCutoffs[3][5];
@@ -745,6 +693,11 @@ public:
     dsp::BiQuad::Coeffs dummy;
     for(int i = 0; i < ctxt->voiceLimit; i++)
     {
+      if(!(mActiveVoices & (1u << i)))
+      {
+        continue;
+      }
+
       const float reso = clipminmaxf(1.f, mParameter[kParamResonance] * 0.1 + mResoMod[i] * 10.f, 10.f);
       const float shift = 1.f + clipminmaxf(-0.5f, mParameter[kParamFormant] * 0.01 + mFormantMod[i], 0.5);
       float syllableStart = clipminmaxf(0.f, mParameter[kParamSyllable] * 0.01 + mSyllableMod[i] * 4.f, 4.f);
@@ -785,237 +738,133 @@ public:
     }
   }
 
-  void ProcessOscx4(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
+  template <int Lanes>
+  void ProcessOsc(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
   {
-    GenerateWaveX4(voiceNum, frames);
-    GenerateNoiseX4(voiceNum, frames);
-
+    typedef VoiceBatch<Lanes> B;
     const int offset = GetBufferOffset(ctxt, voiceNum, frames);
-    float32x4_t filterOut;
-    for(uint32_t i = 0; i < frames; i++)
+    const int quadOffset = frames << 2;
+
+    // released voices cost nothing until they are allocated again
+    if(!IsAnyVoiceActive(voiceNum, Lanes))
     {
-      float32x4_t sample = get_interlaced_samplef32x4(mOscBuffer, i, 0, 4);
-      filterOut = mFormantFilter1.process_so_x4(sample, mFormantCoeffs[0], voiceNum);
-      filterOut = float32x4_add(filterOut, mFormantFilter2.process_so_x4(sample, mFormantCoeffs[1], voiceNum));
-      filterOut = float32x4_add(filterOut, mFormantFilter3.process_so_x4(sample, mFormantCoeffs[2], voiceNum));
-      write_oscillator_output_x4(out, filterOut, offset, ctxt->outputStride, i);
+      for(uint32_t i = 0; i < frames; i++)
+      {
+        B::write_osc_output(out, B::dup(0.f), offset, ctxt->outputStride, i, ctxt->voiceOffset, quadOffset);
+      }
+      return;
     }
-  }
 
-  void ProcessOscx2(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
-  {
-    GenerateWaveX2(voiceNum, frames);
-    GenerateNoiseX2(voiceNum, frames);
-
-    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
-    float32x2_t filterOut;
-    for(uint32_t i = 0; i < frames; i++)
+    // with one quad idle, the other is rendered on its own
+    if(Lanes == kMk2MaxVoices && !(IsAnyVoiceActive(voiceNum, 4) && IsAnyVoiceActive(voiceNum + 4, 4)))
     {
-      float32x2_t sample = get_interlaced_samplef32x2(mOscBuffer, i, 0, 2);
-      filterOut = mFormantFilter1.process_so_x2(sample, mFormantCoeffs[0], voiceNum);
-      filterOut = float32x2_add(filterOut, mFormantFilter2.process_so_x2(sample, mFormantCoeffs[1], voiceNum));
-      filterOut = float32x2_add(filterOut, mFormantFilter3.process_so_x2(sample, mFormantCoeffs[2], voiceNum));
-      write_oscillator_output_x2(out, filterOut, offset, ctxt->outputStride, ctxt->voiceOffset, i);
+      ProcessOsc<4>(ctxt, voiceNum, out, frames);
+      ProcessOsc<4>(ctxt, voiceNum + 4, out, frames);
+      return;
     }
-  }
 
-  void ProcessOscx1(const unit_runtime_osc_context_t * ctxt, int voiceNum, float * out, size_t frames)
-  {
-    GenerateWaveX1(voiceNum, frames);
-    GenerateNoiseX1(voiceNum, frames);
+    GenerateWave<Lanes>(voiceNum, frames);
+    GenerateNoise<Lanes>(voiceNum, frames);
 
-    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
-    float filterOut;
+    typename B::f32 filterOut;
     for(uint32_t i = 0; i < frames; i++)
     {
-      float sample = get_interlaced_sample(mOscBuffer, i, 0, 1);
-      filterOut = mFormantFilter1.process_so_x1(sample, mFormantCoeffs[0], voiceNum);
-      filterOut = filterOut + mFormantFilter2.process_so_x1(sample, mFormantCoeffs[1], voiceNum);
-      filterOut = filterOut + mFormantFilter3.process_so_x1(sample, mFormantCoeffs[2], voiceNum);
-      write_oscillator_output_x1(out, filterOut, offset, ctxt->outputStride, i, ctxt->voiceOffset);
+      typename B::f32 sample = B::get_interlaced(mOscBuffer, i);
+      filterOut = mFormantFilter1.template process_so<Lanes>(sample, mFormantCoeffs[0], voiceNum);
+      filterOut = B::add(filterOut, mFormantFilter2.template process_so<Lanes>(sample, mFormantCoeffs[1], voiceNum));
+      filterOut = B::add(filterOut, mFormantFilter3.template process_so<Lanes>(sample, mFormantCoeffs[2], voiceNum));
+      B::write_osc_output(out, filterOut, offset, ctxt->outputStride, i, ctxt->voiceOffset, quadOffset);
     }
   }
 
-  // original DPW paper https://ieeexplore.ieee.org/abstract/document/5153306
-  // extended https://www.researchgate.net/publication/224557976_Alias-Suppressed_Oscillators_Based_on_Differentiated_Polynomial_Waveforms
-  void GenerateWaveX1(const uint32_t voiceNum, const uint32_t frames)
+  fast_inline bool IsAnyVoiceActive(int voiceNum, int numVoices) const
   {
-    int32_t phase = mPhase[voiceNum];
-    int32_t inc = mPhaseInc[voiceNum];
-    float sawZ = mSawZ[voiceNum];
-    
-    const float invFrames = 1.f / float(frames);
-    const float shapeDelta = (mShape[voiceNum] - mShapeZ[voiceNum]) * invFrames;
-    const float waveLevelDelta = (mWaveLevel[voiceNum] - mWaveLevelZ[voiceNum]) * invFrames;
-    float shapeZ = mShapeZ[voiceNum];
-    float waveLevelZ = mWaveLevelZ[voiceNum];
-    const float dpwGainCompensation = mDpwGainCompensation[voiceNum];
-    for(uint32_t i = 0; i < frames; i++)
-    {
-      // generate naive saw
-      phase = phase + inc;
-      float saw = q31_to_f32(phase);
-
-      // square to get parabolic waveform 
-      float parabolic = saw * saw;
-
-      // differentiate to get saw
-      float dpwSaw = parabolic - sawZ;
-      sawZ = parabolic;
-
-      shapeZ += shapeDelta;
-      float output = (1.f - shapeZ) * (parabolic * 2.f - 1.f) + shapeZ * (dpwSaw * dpwGainCompensation);
-      waveLevelZ += waveLevelDelta;
-      write_to_interlaced_buffer(mOscBuffer, output * waveLevelZ, i, 0, 1);
-    }
-    mPhase[voiceNum] = phase;
-    mSawZ[voiceNum] = sawZ;
-    mShapeZ[voiceNum] = mShape[voiceNum];
-    mWaveLevelZ[voiceNum] = mWaveLevel[voiceNum];
+    return (mActiveVoices >> voiceNum) & ((1u << numVoices) - 1);
   }
 
-  void GenerateWaveX2(const uint32_t voiceNum, const uint32_t frames)
+  // a voice that has been skipped resumes from stale state, clear what would click
+  void WakeVoice(uint8_t voice)
   {
-    int32x2_t phase = s32x2_ld(&mPhase[voiceNum]);
-    int32x2_t inc = s32x2_ld(&mPhaseInc[voiceNum]);
-    float32x2_t sawZ = f32x2_ld(&mSawZ[voiceNum]);
-
-    const float invFrames = 1.f / float(frames);
-    float32x2_t shapeZ = f32x2_ld(&mShapeZ[voiceNum]);
-    float32x2_t waveLevelZ = f32x2_ld(&mWaveLevelZ[voiceNum]);
-    const float32x2_t shapeDelta = float32x2_mulscal(float32x2_sub(f32x2_ld(&mShape[voiceNum]), shapeZ), invFrames);
-    const float32x2_t waveLevelDelta = float32x2_mulscal(float32x2_sub(f32x2_ld(&mWaveLevel[voiceNum]), waveLevelZ), invFrames);
-    const float32x2_t dpwGainCompensation = f32x2_ld(&mDpwGainCompensation[voiceNum]);
-    for(uint32_t i = 0; i < frames; i++)
-    {
-      // generate naive saw
-      phase = int32x2_add(phase, inc);
-      float32x2_t saw = si_i32x2qn_to_f32x2(phase, 31);
-
-      // square to get parabolic waveform 
-      float32x2_t parabolic = float32x2_mul(saw, saw);
-
-      // differentiate to get saw
-      float32x2_t dpwSaw = float32x2_sub(parabolic, sawZ);
-      sawZ = parabolic;
-
-      shapeZ = float32x2_add(shapeZ, shapeDelta);
-      float32x2_t output = float32x2_mul(dpwSaw, dpwGainCompensation);
-      output = float32x2_mul(shapeZ, output);
-      output = float32x2_fmuladd(output, float32x2_sub(f32x2_dup(1.f), shapeZ), float32x2_fmulscaladd(f32x2_dup(-1.f), parabolic, 2.f));
-
-      waveLevelZ = float32x2_add(waveLevelZ, waveLevelDelta);
-      write_to_interlaced_bufferf32x2((float *)mOscBuffer, float32x2_mul(output, waveLevelZ), i, 0, 2);
-    }
-    f32x2_str(&mSawZ[voiceNum], sawZ);
-    s32x2_str(&mPhase[voiceNum], phase);
-    buf_cpy_f32(&mShape[voiceNum], &mShapeZ[voiceNum], 2);
-    buf_cpy_f32(&mWaveLevel[voiceNum], &mWaveLevelZ[voiceNum], 2);
+    mActiveVoices |= 1u << voice;
+    mFormantFilter1.flush(voice);
+    mFormantFilter2.flush(voice);
+    mFormantFilter3.flush(voice);
+
+    // the DPW differentiator restarts from the current phase
+    const float saw = q31_to_f32(mPhase[voice]);
+    mSawZ[voice] = saw * saw;
   }
 
-  void GenerateWaveX4(const uint32_t voiceNum, const uint32_t frames)
+  // original DPW paper https://ieeexplore.ieee.org/abstract/document/5153306
+  // extended https://www.researchgate.net/publication/224557976_Alias-Suppressed_Oscillators_Based_on_Differentiated_Polynomial_Waveforms
+  template <int Lanes>
+  void GenerateWave(const uint32_t voiceNum, const uint32_t frames)
   {
-    int32x4_t phase = s32x4_ld(&mPhase[voiceNum]);
-    int32x4_t inc = s32x4_ld(&mPhaseInc[voiceNum]);
-    float32x4_t sawZ = f32x4_ld(&mSawZ[voiceNum]);
+    typedef VoiceBatch<Lanes> B;
+    typename B::s32 phase = B::lds(&mPhase[voiceNum]);
+    const typename B::s32 inc = B::lds(&mPhaseInc[voiceNum]);
+    typename B::f32 sawZ = B::ld(&mSawZ[voiceNum]);
 
     const float invFrames = 1.f / float(frames);
-    float32x4_t shapeZ = f32x4_ld(&mShapeZ[voiceNum]);
-    float32x4_t waveLevelZ = f32x4_ld(&mWaveLevelZ[voiceNum]);
-    const float32x4_t shapeDelta = float32x4_mulscal(float32x4_sub(f32x4_ld(&mShape[voiceNum]), shapeZ), invFrames);
-    const float32x4_t waveLevelDelta = float32x4_mulscal(float32x4_sub(f32x4_ld(&mWaveLevel[voiceNum]), waveLevelZ), invFrames);
-    const float32x4_t dpwGainCompensation = f32x4_ld(&mDpwGainCompensation[voiceNum]);
+    typename B::f32 shapeZ = B::ld(&mShapeZ[voiceNum]);
+    typename B::f32 waveLevelZ = B::ld(&mWaveLevelZ[voiceNum]);
+    const typename B::f32 shapeDelta = B::mulscal(B::sub(B::ld(&mShape[voiceNum]), shapeZ), invFrames);
+    const typename B::f32 waveLevelDelta = B::mulscal(B::sub(B::ld(&mWaveLevel[voiceNum]), waveLevelZ), invFrames);
+    const typename B::f32 dpwGainCompensation = B::ld(&mDpwGainCompensation[voiceNum]);
     for(uint32_t i = 0; i < frames; i++)
     {
       // generate naive saw
-      phase = int32x4_add(phase, inc);
-      float32x4_t saw = si_i32x4qn_to_f32x4(phase, 31);
+      phase = B::adds(phase, inc);
+      typename B::f32 saw = B::q31_to_float(phase);
 
       // square to get parabolic waveform 
-      float32x4_t parabolic = float32x4_mul(saw, saw);
+      typename B::f32 parabolic = B::mul(saw, saw);
 
       // differentiate to get saw
-      float32x4_t dpwSaw = float32x4_sub(parabolic, sawZ);
+      typename B::f32 dpwSaw = B::sub(parabolic, sawZ);
       sawZ = parabolic;
 
       // scale to -1 ~ 1 for mix
-      parabolic = float32x4_fmulscaladd(f32x4_dup(-1.f), parabolic, 2.f);
+      parabolic = B::fmulscaladd(B::dup(-1.f), parabolic, 2.f);
 
-      shapeZ = float32x4_add(shapeZ, shapeDelta);
-      float32x4_t output = float32x4_mul(dpwSaw, dpwGainCompensation);
-      output = float32x4_mul(shapeZ, output);
-      float32x4_t inverseShape = float32x4_sub(f32x4_dup(1.f), shapeZ);
-      output = float32x4_fmuladd(output, inverseShape, parabolic);
+      shapeZ = B::add(shapeZ, shapeDelta);
+      typename B::f32 output = B::mul(dpwSaw, dpwGainCompensation);
+      output = B::mul(shapeZ, output);
+      typename B::f32 inverseShape = B::sub(B::dup(1.f), shapeZ);
+      output = B::fmuladd(output, inverseShape, parabolic);
 
-      waveLevelZ = float32x4_add(waveLevelZ, waveLevelDelta);
-      write_to_interlaced_bufferf32x4(mOscBuffer, float32x4_mul(output, waveLevelZ), i, 0, 4);
+      waveLevelZ = B::add(waveLevelZ, waveLevelDelta);
+      B::put_interlaced(mOscBuffer, B::mul(output, waveLevelZ), i);
     }
-    f32x4_str(&mSawZ[voiceNum], sawZ);
-    s32x4_str(&mPhase[voiceNum], phase);
-    buf_cpy_f32(&mShape[voiceNum], &mShapeZ[voiceNum], 4);
-    buf_cpy_f32(&mWaveLevel[voiceNum], &mWaveLevelZ[voiceNum], 4);
+    B::str(&mSawZ[voiceNum], sawZ);
+    B::strs(&mPhase[voiceNum], phase);
+    buf_cpy_f32(&mShape[voiceNum], &mShapeZ[voiceNum], Lanes);
+    buf_cpy_f32(&mWaveLevel[voiceNum], &mWaveLevelZ[voiceNum], Lanes);
   }
 
   // https://www.musicdsp.org/en/latest/Synthesis/216-fast-whitenoise-generator.html
-  void GenerateNoiseX1(const uint32_t voiceNum, const uint32_t frames)
-  {
-    const float invFrames = 1.f / float(frames);
-    const float noiseLevelDelta = (mNoiseLevel[voiceNum] - mNoiseLevelZ[voiceNum]) * invFrames;
-    float noiseLevelZ = mNoiseLevelZ[voiceNum];
-    for(uint32_t i = 0; i < frames; i++)
-    {
-      mNoiseX1[voiceNum] ^= mNoiseX2[voiceNum];
-      mNoiseX2[voiceNum] += mNoiseX1[voiceNum];
-      noiseLevelZ += noiseLevelDelta;
-      const float noise = q31_to_f32(mNoiseX2[voiceNum]) * noiseLevelZ;
-      const float osc = get_interlaced_sample(mOscBuffer, i, 0, 1);
-      write_to_interlaced_buffer(mOscBuffer, osc + noise, i, 0, 1);
-    }
-    mNoiseLevelZ[voiceNum] = mNoiseLevel[voiceNum];
-  }
-
-  void GenerateNoiseX2(const uint32_t voiceNum, const uint32_t frames)
-  {
-    const float invFrames = 1.f / float(frames);
-    float32x2_t noiseLevelZ = f32x2_ld(&mNoiseLevelZ[voiceNum]);
-    const float32x2_t noiseLevelDelta = float32x2_mulscal(float32x2_sub(f32x2_ld(&mNoiseLevel[voiceNum]), noiseLevelZ), invFrames);
-    int32x2_t noiseX1 = s32x2_ld(&mNoiseX1[voiceNum]);
-    int32x2_t noiseX2 = s32x2_ld(&mNoiseX2[voiceNum]);
-    for(uint32_t i = 0; i < frames; i++)
-    {
-      noiseX1 = veor_s32(noiseX1, noiseX2);
-      noiseX2 = int32x2_add(noiseX2, noiseX1);
-
-      noiseLevelZ = float32x2_add(noiseLevelZ, noiseLevelDelta);
-      const float32x2_t noise = float32x2_mul(si_i32x2qn_to_f32x2(noiseX2, 31), noiseLevelZ);
-      const float32x2_t osc = get_interlaced_samplef32x2(mOscBuffer, i, 0, 2);
-      write_to_interlaced_bufferf32x2(mOscBuffer, float32x2_add(osc, noise), i, 0, 2);
-    }
-    buf_cpy_f32(&mNoiseLevel[voiceNum], &mNoiseLevelZ[voiceNum], 2);
-    s32x2_str(&mNoiseX1[voiceNum], noiseX1);
-    s32x2_str(&mNoiseX2[voiceNum], noiseX2);
-  }
-
-  void GenerateNoiseX4(const uint32_t voiceNum, const uint32_t frames)
+  template <int Lanes>
+  void GenerateNoise(const uint32_t voiceNum, const uint32_t frames)
   {
+    typedef VoiceBatch<Lanes> B;
     const float invFrames = 1.f / float(frames);
-    float32x4_t noiseLevelZ = f32x4_ld(&mNoiseLevelZ[voiceNum]);
-    const float32x4_t noiseLevelDelta = float32x4_mulscal(float32x4_sub(f32x4_ld(&mNoiseLevel[voiceNum]), noiseLevelZ), invFrames);
-    int32x4_t noiseX1 = s32x4_ld(&mNoiseX1[voiceNum]);
-    int32x4_t noiseX2 = s32x4_ld(&mNoiseX2[voiceNum]);
+    typename B::f32 noiseLevelZ = B::ld(&mNoiseLevelZ[voiceNum]);
+    const typename B::f32 noiseLevelDelta = B::mulscal(B::sub(B::ld(&mNoiseLevel[voiceNum]), noiseLevelZ), invFrames);
+    typename B::s32 noiseX1 = B::lds(&mNoiseX1[voiceNum]);
+    typename B::s32 noiseX2 = B::lds(&mNoiseX2[voiceNum]);
     for(uint32_t i = 0; i < frames; i++)
     {
-      noiseX1 = veorq_s32(noiseX1, noiseX2);
-      noiseX2 = int32x4_add(noiseX2, noiseX1);
+      noiseX1 = B::eors(noiseX1, noiseX2);
+      noiseX2 = B::adds(noiseX2, noiseX1);
 
-      noiseLevelZ = float32x4_add(noiseLevelZ, noiseLevelDelta);
-      const float32x4_t noise = float32x4_mul(si_i32x4qn_to_f32x4(noiseX2, 31), noiseLevelZ);
-      const float32x4_t osc = get_interlaced_samplef32x4(mOscBuffer, i, 0, 4);
-      write_to_interlaced_bufferf32x4(mOscBuffer, float32x4_add(osc, noise), i, 0, 4);
+      noiseLevelZ = B::add(noiseLevelZ, noiseLevelDelta);
+      const typename B::f32 noise = B::mul(B::q31_to_float(noiseX2), noiseLevelZ);
+      const typename B::f32 osc = B::get_interlaced(mOscBuffer, i);
+      B::put_interlaced(mOscBuffer, B::add(osc, noise), i);
     }
-    buf_cpy_f32(&mNoiseLevel[voiceNum], &mNoiseLevelZ[voiceNum], 4);
-    s32x4_str(&mNoiseX1[voiceNum], noiseX1);
-    s32x4_str(&mNoiseX2[voiceNum], noiseX2);
+    buf_cpy_f32(&mNoiseLevel[voiceNum], &mNoiseLevelZ[voiceNum], Lanes);
+    B::strs(&mNoiseX1[voiceNum], noiseX1);
+    B::strs(&mNoiseX2[voiceNum], noiseX2);
   }
 
   fast_inline int32_t CookEGTime(float paramValue, const int32_t min, const int32_t max)
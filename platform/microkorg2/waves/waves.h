@@ -5,7 +5,11 @@
 #include "unit_osc.h"
 #include "runtime.h"
 #include "utils/mk2_utils.h"
+#include "utils/mod_matrix.h"
 #include "dsp/mk2_biquad.hpp"
+#include "dsp/NoiseBlock.h"
+#include "dsp/Oversampler.h"
+#include "dsp/WaveMip.h"
 #include "utils/io_ops.h"
 #include "waves_common.h"
 #include "macros.h"
@@ -88,6 +92,9 @@ public:
     float                     bit_res_recip; // bit depth scaling reciprocal, returns signal to 0.-1.f after scaling/rounding
     float                     imperfection;  // tuning imperfection
     std::atomic_uint_fast32_t flags;         // flags passed to audio processing thread
+    dsp::WaveMip              wave_a_mip;    // band-limited mip levels of wave a
+    dsp::WaveMip              wave_b_mip;    // band-limited mip levels of wave b
+    dsp::WaveMip              sub_wave_mip;  // band-limited mip levels of sub wave
     
     State(void) :
       wave_a(wavesA[0]),
@@ -96,6 +103,7 @@ public:
       dither(0.f),
       bit_res(1.f),
       bit_res_recip(1.f),
+      imperfection(0.f),
       flags{k_flags_none}
     {
       buf_fill_f32(w0_a, 440.f * k_samplerate_recipf, kMk2MaxVoices);
@@ -105,7 +113,6 @@ public:
       buf_clr_f32(shapeModZ, kMk2MaxVoices);
 
       Reset();
-      imperfection = osc_white() * 1.0417e-006f; // +/- 0.05Hz@48KHz
     }
     
     inline void Reset(void) {
@@ -125,6 +132,12 @@ public:
     // kModDestBitCrush,
     kNumModDest
   };
+
+  // 4 harmonics per wave and block, a wave change is band-limited after 9 blocks
+  enum
+  {
+    kMipStepsPerBlock = 4
+  };
   
   /*===========================================================================*/
   /* Lifecycle Methods. */
@@ -157,13 +170,23 @@ public:
     // Cache runtime descriptor to keep access to API hooks
     runtime_desc_ = *desc;
 
+    mod_matrix_.SetDestination(kModDestShape, state_.shapeMod);
+
     // Initialize pre/post filter coefficients
     prelpf_.mCoeffs.setPoleLP(0.9f);
     postlpf_.mCoeffs.setFOLP(osc_tanpif(0.45f));
+    shaper_os_.Reset();
 
     // Make sure parameters are reset to default values
     params_.reset();
 
+    // Seed from the instance address so that several instances decorrelate
+    noise_.Seed(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)));
+    state_.imperfection = noise_.White() * 1.0417e-006f; // +/- 0.05Hz@48KHz
+
+    // Build band-limited mip levels for the default waves
+    state_.flags.fetch_or(State::k_flag_wave_a | State::k_flag_wave_b | State::k_flag_sub_wave);
+
     return k_unit_err_none;
   }
 
@@ -214,14 +237,25 @@ public:
         s.bit_res_recip = 1.f / s.bit_res;
       }
     }
+
+    // Band-limited mip levels are built a few harmonics per block
+    s.wave_a_mip.Build(kMipStepsPerBlock);
+    s.wave_b_mip.Build(kMipStepsPerBlock);
+    s.sub_wave_mip.Build(kMipStepsPerBlock);
    
     for(int i = 0; i < ctxt->voiceLimit; i++)
     {
       uint8_t noteWhole = static_cast<uint8_t>(ctxt->pitch[i]);
       float frac = ctxt->pitch[i] - static_cast<float>(noteWhole);
       updatePitch(osc_w0f_for_note(noteWhole, static_cast<uint8_t>(frac * 0xFF)), i);
-      ProcessX1(out, i, frames);
     }
+
+    // Render voices four at a time, remaining voices one by one
+    int voice = 0;
+    for(; voice + 4 <= ctxt->voiceLimit; voice += 4)
+      ProcessX4(out, voice, frames);
+    for(; voice < ctxt->voiceLimit; voice++)
+      ProcessX1(out, voice, frames);
   }
 
   inline void setParameter(uint8_t index, int32_t value) 
@@ -369,24 +403,7 @@ public:
     {
       case kMk2PlatformExclusiveModData:
       {
-        float * modDepth = GetModDepth(data);
-        int32_t * index = GetModIndex(data);
-
-        buf_clr_f32(state_.shapeMod, kMk2MaxVoices);
-
-        float * shapeMod = state_.shapeMod;
-        for(int voice = 0; voice < ctxt->voiceLimit; voice+=4)
-        {
-          for(int modDest = 0; modDest < kNumMk2ModSrc; modDest++)
-          {
-            if(index[modDest] != kModDestShape) continue;
-
-            float32x4_t currentValue = f32x4_ld(&shapeMod[voice]);
-            float * modData = GetModSourceData(data, modDest, ctxt->voiceLimit, voice);
-            currentValue = float32x4_fmulscaladd(currentValue, f32x4_ld(modData), modDepth[modDest]);
-            f32x4_str(&shapeMod[voice], currentValue);
-          }
-        }
+        mod_matrix_.Process(data, ctxt->voiceLimit);
         break;
       }
     
@@ -445,6 +462,9 @@ public:
   State       state_;
   Params      params_;
   dsp::ParallelBiQuad<kMk2MaxVoices> prelpf_, postlpf_;
+  dsp::NoiseBlock noise_;  // bit crusher dither and tuning imperfection
+  dsp::Oversampler<2, kMk2MaxVoices> shaper_os_;  // 2x around the tanh stage
+  ModMatrix<kNumModDest> mod_matrix_;
   unit_runtime_desc_t runtime_desc_;
 
   std::atomic_uint_fast32_t flags_;
@@ -483,6 +503,7 @@ public:
         idx -= k_b_thr;
       }
       state_.wave_a = table[idx];
+      state_.wave_a_mip.SetWave(state_.wave_a);
     }
     if (flags & State::k_flag_wave_b) {
       static const uint8_t k_d_thr = k_waves_d_cnt;
@@ -504,9 +525,11 @@ public:
       }
       
       state_.wave_b = table[idx];
+      state_.wave_b_mip.SetWave(state_.wave_b);
     }
     if (flags & State::k_flag_sub_wave) {
       state_.sub_wave = wavesA[params_.sub_wave];
+      state_.sub_wave_mip.SetWave(state_.sub_wave);
     }
   }
 
@@ -523,6 +546,11 @@ public:
     const float w0_a = s.w0_a[voiceNum];
     const float w0_b = s.w0_b[voiceNum];
     const float w0_sub = s.w0_sub[voiceNum];
+
+    // Mip levels are picked once per block
+    const dsp::WaveMip::Level level_a = s.wave_a_mip.GetLevel(w0_a);
+    const dsp::WaveMip::Level level_b = s.wave_b_mip.GetLevel(w0_b);
+    const dsp::WaveMip::Level level_sub = s.sub_wave_mip.GetLevel(w0_sub);
     
     float shape_mod_z = s.shapeModZ[voiceNum];
     const float shape_mod_inc = (s.shapeMod[voiceNum] - shape_mod_z) / frames;
@@ -536,17 +564,17 @@ public:
     {
       const float wave_mix = clip01f(p.shape+shape_mod_z);
       
-      float sig = (1.f - wave_mix) * osc_wave_scanf(s.wave_a, phi_a);
-      sig += wave_mix * osc_wave_scanf(s.wave_b, phi_b);
+      float sig = (1.f - wave_mix) * dsp::WaveMip::Scan(level_a, phi_a);
+      sig += wave_mix * dsp::WaveMip::Scan(level_b, phi_b);
     
-      const float sub_sig = osc_wave_scanf(s.sub_wave, phi_sub);
+      const float sub_sig = dsp::WaveMip::Scan(level_sub, phi_sub);
       sig = (1.f - ring_mix) * sig + ring_mix * 1.4125375446227544f * (sub_sig * sig);
       sig += sub_mix * sub_sig;
       sig *= 1.4125375446227544f;
-      sig = clip1m1f(fastertanh2f(sig));
+      sig = shaper_os_.ProcessX1(sig, [](float x) { return clip1m1f(fastertanh2f(x)); }, voiceNum);
     
       sig = prelpf_.process_fo_x1(sig, voiceNum);
-      sig += s.dither * osc_white();
+      sig += s.dither * noise_.White();
       sig = si_roundf(sig * s.bit_res) * s.bit_res_recip;
       sig = postlpf_.process_fo_x1(sig, voiceNum);
       
@@ -568,6 +596,107 @@ public:
     s.shapeModZ[voiceNum] = shape_mod_z;    
   }
 
+  void ProcessX4(float * out, const uint32_t voiceNum, const size_t frames)
+  {
+    State &s = state_;
+    const Waves::Params &p = params_;
+    const unit_runtime_osc_context_t *ctxt = static_cast<const unit_runtime_osc_context_t *>(runtime_desc_.hooks.runtime_context);
+
+    // Temporaries.
+    float32x4_t phi_a = f32x4_ld(&s.phi_a[voiceNum]);
+    float32x4_t phi_b = f32x4_ld(&s.phi_b[voiceNum]);
+    float32x4_t phi_sub = f32x4_ld(&s.phi_sub[voiceNum]);
+    const float32x4_t w0_a = f32x4_ld(&s.w0_a[voiceNum]);
+    const float32x4_t w0_b = f32x4_ld(&s.w0_b[voiceNum]);
+    const float32x4_t w0_sub = f32x4_ld(&s.w0_sub[voiceNum]);
+
+    float32x4_t shape_mod_z = f32x4_ld(&s.shapeModZ[voiceNum]);
+    const float32x4_t shape_mod_inc = float32x4_mulscal(float32x4_sub(f32x4_ld(&s.shapeMod[voiceNum]), shape_mod_z), 1.f / frames);
+
+    // Waves are shared by all voices, mip levels are picked per voice once per block
+    const MipLevelX4 level_a(s.wave_a_mip, &s.w0_a[voiceNum]);
+    const MipLevelX4 level_b(s.wave_b_mip, &s.w0_b[voiceNum]);
+    const MipLevelX4 level_sub(s.sub_wave_mip, &s.w0_sub[voiceNum]);
+
+    const float sub_mix = p.sub_mix * 0.5011872336272722f;
+    const float ring_mix = p.ring_mix;
+
+    const int offset = GetBufferOffset(ctxt, voiceNum, frames);
+    const float outputTrim = 0.3f;
+    for(uint32_t i = 0; i < frames; i++)
+    {
+      const float32x4_t wave_mix = clip01fx4(float32x4_addscal(shape_mod_z, p.shape));
+
+      float32x4_t sig = float32x4_mul(float32x4_sub(f32x4_dup(1.f), wave_mix), level_a.Scan(phi_a));
+      sig = float32x4_fmuladd(sig, wave_mix, level_b.Scan(phi_b));
+
+      const float32x4_t sub_sig = level_sub.Scan(phi_sub);
+      sig = float32x4_fmulscaladd(float32x4_mulscal(sig, 1.f - ring_mix), float32x4_mul(sub_sig, sig), ring_mix * 1.4125375446227544f);
+      sig = float32x4_fmulscaladd(sig, sub_sig, sub_mix);
+      sig = float32x4_mulscal(sig, 1.4125375446227544f);
+      sig = shaper_os_.ProcessX4(sig, [](float32x4_t x) { return clip1m1fx4(fastertanh2fx4(x)); }, voiceNum);
+
+      sig = prelpf_.process_fo_x4(sig, voiceNum);
+      sig = float32x4_fmulscaladd(sig, noise_.WhiteX4(), s.dither);
+      sig = float32x4_mulscal(si_roundfx4(float32x4_mulscal(sig, s.bit_res)), s.bit_res_recip);
+      sig = postlpf_.process_fo_x4(sig, voiceNum);
+
+      write_oscillator_output_x4(out, float32x4_mulscal(sig, outputTrim), offset, ctxt->outputStride, i);
+
+      phi_a = float32x4_add(phi_a, w0_a);
+      phi_a = float32x4_sub(phi_a, si_u32x4_to_f32x4(si_f32x4_to_u32x4(phi_a)));
+      phi_b = float32x4_add(phi_b, w0_b);
+      phi_b = float32x4_sub(phi_b, si_u32x4_to_f32x4(si_f32x4_to_u32x4(phi_b)));
+      phi_sub = float32x4_add(phi_sub, w0_sub);
+      phi_sub = float32x4_sub(phi_sub, si_u32x4_to_f32x4(si_f32x4_to_u32x4(phi_sub)));
+      shape_mod_z = float32x4_add(shape_mod_z, shape_mod_inc);
+    }
+
+    // Update state
+    f32x4_str(&s.phi_a[voiceNum], phi_a);
+    f32x4_str(&s.phi_b[voiceNum], phi_b);
+    f32x4_str(&s.phi_sub[voiceNum], phi_sub);
+    f32x4_str(&s.shapeModZ[voiceNum], shape_mod_z);
+  }
+
+  // Mip levels of four voices, picked once per block
+  struct MipLevelX4
+  {
+    MipLevelX4(const dsp::WaveMip & mip, const float * w0)
+    {
+      float fr[4];
+      for (int i = 0; i < 4; i++)
+      {
+        const dsp::WaveMip::Level level = mip.GetLevel(w0[i]);
+        lo[i] = level.lo;
+        hi[i] = level.hi;
+        fr[i] = level.frac;
+      }
+      frac = f32x4_ld(fr);
+    }
+
+    fast_inline float32x4_t Scan(float32x4_t x) const
+    {
+      return linintfx4(frac, osc_wave_scanfx4(lo, x), osc_wave_scanfx4(hi, x));
+    }
+
+    const float * lo[4];
+    const float * hi[4];
+    float32x4_t frac;
+  };
+
+  // Vector version of fastertanh2f(), reciprocal estimate refined by two Newton-Raphson steps
+  static fast_inline float32x4_t fastertanh2fx4(float32x4_t x)
+  {
+    const float32x4_t xx = float32x4_mul(x, x);
+    const float32x4_t num = float32x4_mul(x, float32x4_addscal(xx, 27.f));
+    const float32x4_t den = float32x4_addscal(float32x4_mulscal(xx, 9.f), 27.f);
+    float32x4_t r = float32x4_rcp(den);
+    r = float32x4_mul(r, float32x4_sub(f32x4_dup(2.f), float32x4_mul(den, r)));
+    r = float32x4_mul(r, float32x4_sub(f32x4_dup(2.f), float32x4_mul(den, r)));
+    return float32x4_mul(num, r);
+  }
+
   /*===========================================================================*/
   /* Constants. */
   /*===========================================================================*/
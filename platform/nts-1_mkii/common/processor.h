@@ -6,6 +6,36 @@
 class Processor
 {
 public:
+    // linear ramp of a control rate value across one sub-block of processControlRate()
+    struct ControlRamp
+    {
+        float value = 0.f;
+        float inc = 0.f;
+        float target = 0.f;
+
+        // ramps from the previous target to t over the next frames samples
+        void set(float t, uint32_t frames)
+        {
+            value = target;
+            target = t;
+            inc = (t - value) / frames;
+        }
+
+        // jumps to t, e.g. on reset
+        void reset(float t)
+        {
+            value = target = t;
+            inc = 0.f;
+        }
+
+        // reaches the target on the last sample of the sub-block
+        float process()
+        {
+            value += inc;
+            return value;
+        }
+    };
+
     // returns the sample rate, which is 48k for all logue-sdk products
     static constexpr float getSampleRate() { return 48000.f; }
 
@@ -18,6 +48,13 @@ public:
 
     virtual void process(const float *__restrict in, float *__restrict out, uint32_t frames) = 0;
 
+    // called by processControlRate() before each sub-block, frames is the length of the sub-block.
+    // Cook expensive coefficients here and set their ControlRamps
+    virtual void control(uint32_t frames)
+    {
+        (void)frames;
+    }
+
     // note: the deconstructor will not be called for the static instance
     // so make sure to free any resources in this function
     virtual void teardown() {};
@@ -89,4 +126,23 @@ public:
     {
         (void)counter;
     }
+
+protected:
+    // Splits a render into sub-blocks of BlockSize frames, the last one may be shorter,
+    // and calls control() then render(in, out, frames) for each of them. Control rate
+    // work then runs at getSampleRate() / BlockSize whatever the buffer size.
+    template <uint32_t BlockSize, uint32_t InChannels, uint32_t OutChannels, typename Render>
+    void processControlRate(const float *__restrict in, float *__restrict out, uint32_t frames, Render &&render)
+    {
+        static_assert(BlockSize > 0, "BlockSize must not be 0");
+        while (frames > 0)
+        {
+            const uint32_t n = (frames < BlockSize) ? frames : BlockSize;
+            control(n);
+            render(in, out, n);
+            in += n * InChannels;
+            out += n * OutChannels;
+            frames -= n;
+        }
+    }
 };
\ No newline at end of file
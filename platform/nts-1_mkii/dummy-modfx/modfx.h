@@ -136,26 +136,44 @@ public:
   {
     buffer_ = allocated_buffer;
     params_.reset();
+    depth_.reset(params_.depth);
   }
 
   void teardown() override final { buffer_ = nullptr; }
   // audio processing callbacks
   void process(const float *__restrict in, float *__restrict out, uint32_t frames) override final
   {
-    // Caching current parameter values. Consider smoothing sensitive parameters in audio loop
-    const Params p = params_;
-
-    for (const float *out_end = out + frames * 2; out != out_end; in += 2, out += 2)
+    // Note: Parameters are cooked in control() every CONTROL_FRAMES samples, whatever the buffer size
+    processControlRate<CONTROL_FRAMES, 2, 2>(in, out, frames, [this](const float *__restrict in, float *__restrict out, uint32_t frames)
     {
-      // Process samples here
+      for (const float *out_end = out + frames * 2; out != out_end; in += 2, out += 2)
+      {
+        // Smoothly interpolated across the sub-block
+        const float depth = depth_.process();
+        (void)depth;
+
+        // Process samples here
+
+        // pass through
+        out[0] = in[0]; // left sample
+        out[1] = in[1]; // right sample
+      }
+    });
+  }
 
-      // pass through
-      out[0] = in[0]; // left sample
-      out[1] = in[1]; // right sample
-    }
+  // control rate callback, called before each sub-block of process()
+  void control(uint32_t frames) override final
+  {
+    // Caching current parameter values. Expensive coefficient cooking belongs here
+    const Params p = params_;
+
+    depth_.set(p.depth, frames);
   }
 
 private:
+  static constexpr uint32_t CONTROL_FRAMES = 16; // 3 kHz control rate
+
   float *buffer_; // valid range is from buffer_ to buffer_ + getBufferSize() (exclusive)
   Params params_;
+  ControlRamp depth_;
 };
\ No newline at end of file
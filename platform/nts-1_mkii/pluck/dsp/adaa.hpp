@@ -0,0 +1,98 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "dsp/AdaaTables.h"
+
+// first-order antiderivative antialiased (ADAA) overdrive, the scalar
+// counterpart of dsp::Adaa1<dsp::adaa::Overdrive> in common/dsp/Adaa.h
+//
+// lerp(x, fast_tanh(x * g), m) with g = 24 * drive^3, m = drive * (2 - drive),
+// fast_tanh(u) = u / 9 + (8 / 3) * u / (u^2 + 3)
+//
+// The output is the mean of the curve between consecutive inputs,
+// (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), which suppresses aliasing without
+// running the curve at a higher rate. Adds half a sample of delay. The rational
+// part of fast_tanh and its antiderivative come from the kFastTanhRest* tables,
+// so no log is needed per sample.
+class AdaaOverdrive
+{
+public:
+  void set_drive(float drive)
+  {
+    const float d = std::min(std::max(drive, 0.f), 1.f);
+    const float gain = d * d * d * 24.f;
+    // below this the shaped path is linear to float precision
+    const float mix = (gain < 1e-3f) ? 0.f : d * (2.f - d);
+    slope = (1.f - mix) + mix * gain * (1.f / 9.f);
+    rest_gain = gain;
+    rest_mix = mix;
+    rest_scale = (gain > 0.f) ? mix / gain : 0.f;
+    // refresh the stored antiderivative so that a drive change does not click
+    f1_z = f1(x_z);
+  }
+
+  void reset()
+  {
+    x_z = 0.f;
+    f1_z = 0.f;
+  }
+
+  float process(float x)
+  {
+    const float f = f1(x);
+    const float dx = x - x_z;
+    const float y = (std::abs(dx) < epsilon) ? f0(0.5f * (x + x_z)) : (f - f1_z) / dx;
+    x_z = x;
+    f1_z = f;
+    return y;
+  }
+
+private:
+  // float32 rounding of F1 dominates below this
+  static constexpr float epsilon = 1e-3f;
+  static constexpr size_t table_size = 128;
+  static constexpr float table_range = 24.f;
+
+  // segment index and position in it, past the range the last value is held
+  static size_t lookup(float a, float &s)
+  {
+    const float range = table_range;
+    const float idx = (a < range ? a : range) * (table_size / range);
+    const size_t i = std::min(static_cast<size_t>(idx), table_size - 1);
+    s = idx - i;
+    return i;
+  }
+
+  float f0(float x) const
+  {
+    const float a = std::abs(x * rest_gain);
+    float s;
+    const size_t i = lookup(a, s);
+    const float *t = dsp::adaa::kFastTanhRestF0;
+    const float rest = t[i] + s * (t[i + 1] - t[i]);
+    return slope * x + rest_mix * std::copysign(rest, x);
+  }
+
+  // F1 of the interpolated table, continued linearly past the range
+  float f1(float x) const
+  {
+    const float a = std::abs(x * rest_gain);
+    float s;
+    const size_t i = lookup(a, s);
+    const float *t = dsp::adaa::kFastTanhRestF0;
+    const float ds = s * (table_range / table_size);
+    const float y0 = t[i];
+    const float over = (a < table_range) ? 0.f : a - table_range;
+    const float rest = dsp::adaa::kFastTanhRestF1[i] + ds * (y0 + 0.5f * (t[i + 1] - y0) * s) + t[table_size] * over;
+    return 0.5f * slope * x * x + rest_scale * rest;
+  }
+
+  float slope = 1.f;      // of the linear part, dry mix plus u / 9
+  float rest_gain = 0.f;  // input gain of the rational part
+  float rest_mix = 0.f;   // rational part scale in F0
+  float rest_scale = 0.f; // rational part scale in F1
+  float x_z = 0.f;
+  float f1_z = 0.f;
+};
@@ -46,15 +46,8 @@
 #include "dsp/one_pole.hpp"
 #include "dsp/dc_blocker.hpp"
 #include "dsp/thiran_allpass.hpp"
-
-inline float overdrive(float x, float drive)
-{
-  const float d = clampf(drive, 0.f, 1.f);
-  const float pre_gain = d * d * d * 24.f;
-  const float distorted = fast_tanh(x * pre_gain);
-  const float mix = d * (2.f - d);
-  return lerpf(x, distorted, mix);
-}
+#include "dsp/adaa.hpp"
+#include "dsp/NoiseBlock.h"
 
 class Osc : public Processor
 {
@@ -153,6 +146,8 @@ public:
     curved_bridge = 0.f;
     dispersion_filter.reset();
     dc_blocker.reset(getSampleRate());
+    noise.Seed(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)));
+    overdrive.reset();
   }
 
   void noteOn(uint8_t note, uint8_t velocity) override final
@@ -170,9 +165,8 @@ public:
     const float string_len = compute_string_len_samples(pitch);
     for (size_t i = 0; i < static_cast<size_t>(string_len) + 1; ++i)
     {
-      float noise = osc_white();
-      noise = noise_filter.process_sample(noise);
-      delay.write(noise);
+      const float burst = noise_filter.process_sample(noise.White());
+      delay.write(burst);
     }
   }
 
@@ -206,13 +200,15 @@ public:
     // stiffness: [0, 1] -> [0, 0.01]
     const float bridge_amount = p.stiffness * p.stiffness * 0.01f;
 
+    overdrive.set_drive(p.drive);
+
     for (const float *out_end = out + frames; out != out_end; in += 2, out += 1)
     {
       // curved bridge shortens the string by 1% maximum
       float string_len_modulated = string_len * (1 - curved_bridge * bridge_amount);
 
       // noise FM on string length
-      string_len_modulated = string_len_modulated * (1.f + osc_white() * p.noise_fm_amount * 0.025f);
+      string_len_modulated = string_len_modulated * (1.f + noise.White() * p.noise_fm_amount * 0.025f);
 
       // read delayline with modulated length
       const float delay_out = delay.read_lagrange_2nd(string_len_modulated);
@@ -229,7 +225,8 @@ public:
       // update curved bridge from output
       curved_bridge = compute_curved_bridge(y);
 
-      y = overdrive(y, p.drive);
+      // antiderivative antialiased, keeps the harmonics from aliasing without oversampling
+      y = overdrive.process(y);
 
       out[0] = y;
 
@@ -273,6 +270,8 @@ private:
   SymmetricFir3 damp_filter;
   OnePole noise_filter;
   DcBlocker dc_blocker;
+  AdaaOverdrive overdrive;
+  dsp::NoiseBlock noise;
 
   float curved_bridge = 0.f;
 
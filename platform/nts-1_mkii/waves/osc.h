@@ -48,6 +48,8 @@
 #include "unit_osc.h"
 #include "waves_common.h"
 #include "dsp/biquad.hpp"
+#include "dsp/WaveMip.h"
+#include "dsp/NoiseBlock.h"
 
 class Osc : public Processor
 {
@@ -168,6 +170,12 @@ public:
     postlpf_.mCoeffs.setFOLP(osc_tanpif(0.45f));
 
     params_.reset();
+
+    noise_.Seed(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)));
+    state_.imperfection = noise_.White() * 1.0417e-006f; // +/- 0.05Hz@48KHz
+
+    // start building band-limited mip levels for the default waves
+    state_.flags.fetch_or(State::k_flag_wave_a | State::k_flag_wave_b | State::k_flag_sub_wave);
   }
 
   void reset() override final
@@ -213,6 +221,14 @@ public:
       }
     }
 
+    // Band-limited mip levels are built a few harmonics per block, and picked once per block
+    s.wave_a_mip.Build(k_mip_steps_per_block);
+    s.wave_b_mip.Build(k_mip_steps_per_block);
+    s.sub_wave_mip.Build(k_mip_steps_per_block);
+    const dsp::WaveMip::Level level_a = s.wave_a_mip.GetLevel(s.w0_a);
+    const dsp::WaveMip::Level level_b = s.wave_b_mip.GetLevel(s.w0_b);
+    const dsp::WaveMip::Level level_sub = s.sub_wave_mip.GetLevel(s.w0_sub);
+
     // Temporaries.
     float phi_a = s.phi_a;
     float phi_b = s.phi_b;
@@ -230,17 +246,17 @@ public:
     {
       const float wave_mix = clip01f(p.shape + lfoz);
 
-      float sig = (1.f - wave_mix) * osc_wave_scanf(s.wave_a, phi_a);
-      sig += wave_mix * osc_wave_scanf(s.wave_b, phi_b);
+      float sig = (1.f - wave_mix) * dsp::WaveMip::Scan(level_a, phi_a);
+      sig += wave_mix * dsp::WaveMip::Scan(level_b, phi_b);
 
-      const float sub_sig = osc_wave_scanf(s.sub_wave, phi_sub);
+      const float sub_sig = dsp::WaveMip::Scan(level_sub, phi_sub);
       sig = (1.f - ring_mix) * sig + ring_mix * 1.4125375446227544f * (sub_sig * sig);
       sig += sub_mix * sub_sig;
       sig *= 1.4125375446227544f;
       sig = clip1m1f(fastertanh2f(sig));
 
       sig = prelpf_.process_fo(sig);
-      sig += s.dither * osc_white();
+      sig += s.dither * noise_.White();
       sig = si_roundf(sig * s.bit_res) * s.bit_res_recip;
       sig = postlpf_.process_fo(sig);
 
@@ -270,6 +286,12 @@ public:
   }
 
 private:
+  // 4 harmonics per wave and block, a wave change is band-limited after 9 blocks
+  enum
+  {
+    k_mip_steps_per_block = 4
+  };
+
   struct State
   {
 
@@ -298,13 +320,16 @@ private:
     float dither = 0.f;                            // dithering amount before bit reduction
     float bit_res = 1.f;                           // bit depth scaling factor
     float bit_res_recip = 1.f;                     // bit depth scaling reciprocal, returns signal to 0.-1.f after scaling/rounding
-    float imperfection;                            // tuning imperfection
+    float imperfection = 0.f;                      // tuning imperfection, drawn in init
     std::atomic_uint_fast32_t flags{k_flags_none}; // flags passed to audio processing thread
 
+    dsp::WaveMip wave_a_mip;                       // band-limited mip levels of wave a
+    dsp::WaveMip wave_b_mip;                       // band-limited mip levels of wave b
+    dsp::WaveMip sub_wave_mip;                     // band-limited mip levels of sub wave
+
     State(void)
     {
       reset();
-      imperfection = osc_white() * 1.0417e-006f; // +/- 0.05Hz@48KHz
     }
 
     inline void reset(void)
@@ -319,6 +344,7 @@ private:
   State state_;
   Params params_;
   dsp::BiQuad prelpf_, postlpf_;
+  dsp::NoiseBlock noise_;
 
   float w0_;
   float lfo_;
@@ -360,6 +386,7 @@ private:
         idx -= k_b_thr;
       }
       state_.wave_a = table[idx];
+      state_.wave_a_mip.SetWave(state_.wave_a);
     }
     if (flags & State::k_flag_wave_b)
     {
@@ -386,11 +413,13 @@ private:
       }
 
       state_.wave_b = table[idx];
+      state_.wave_b_mip.SetWave(state_.wave_b);
     }
     if (flags & State::k_flag_sub_wave)
     {
       const uint8_t idx = params_.sub_wave;
       state_.sub_wave = wavesA[params_.sub_wave];
+      state_.sub_wave_mip.SetWave(state_.sub_wave);
     }
   }
 };
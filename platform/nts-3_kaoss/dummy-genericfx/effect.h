@@ -144,6 +144,7 @@ public:
   {
     buffer_ = allocated_buffer;
     params_.reset();
+    depth_.reset(params_.depth);
   }
 
   void teardown() override final { buffer_ = nullptr; }
@@ -151,15 +152,29 @@ public:
   // audio processing callbacks
   void process(const float *__restrict in, float *__restrict out, uint32_t frames) override final
   {
-    // Caching current parameter values. Consider smoothing sensitive parameters in audio loop
+    // Note: Parameters are cooked in control() every CONTROL_FRAMES samples, whatever the buffer size
+    processControlRate<CONTROL_FRAMES, 2, 2>(in, out, frames, [this](const float *__restrict in, float *__restrict out, uint32_t frames)
+    {
+      for (const float *out_end = out + frames * 2; out != out_end; in += 2, out += 2)
+      {
+        // Smoothly interpolated across the sub-block
+        const float depth = depth_.process();
+        (void)depth;
+
+        // Process samples here
+        out[0] = in[0];
+        out[1] = in[1];
+      }
+    });
+  }
+
+  // control rate callback, called before each sub-block of process()
+  void control(uint32_t frames) override final
+  {
+    // Caching current parameter values. Expensive coefficient cooking belongs here
     const Params p = params_;
 
-    for (const float *out_end = out + frames * 2; out != out_end; in += 2, out += 2)
-    {
-      // Process samples here
-      out[0] = in[0];
-      out[1] = in[1];
-    }
+    depth_.set(p.depth, frames);
   }
 
   inline void touchEvent(uint8_t id, uint8_t phase, uint32_t x, uint32_t y) override final
@@ -189,6 +204,9 @@ public:
   }
 
 private:
+  static constexpr uint32_t CONTROL_FRAMES = 16; // 3 kHz control rate
+
   float *buffer_; // valid range:  [buffer_, buffer_ + getBufferSize())
   Params params_;
+  ControlRamp depth_;
 };
@@ -4,6 +4,8 @@
 
 #include "utility.hpp"
 
+// N is the capacity of the assigned memory. Only the first size() samples are
+// addressed, so short strings keep a small working set and clear quickly.
 template <size_t N>
 class DelayLine
 {
@@ -15,6 +17,22 @@ public:
     samples = mem;
   }
 
+  // Shrinks the active region to the smallest power of 2 >= min_length (up to N).
+  // Content is not preserved, call clear() afterwards.
+  void resize(size_t min_length)
+  {
+    size_t len = 2;
+    while (len < min_length && len < N)
+      len <<= 1;
+    mask = len - 1;
+    current_pos = 0;
+  }
+
+  size_t size() const { return mask + 1; }
+
+  // longest delay that can be read with 2nd order interpolation
+  float max_delay() const { return static_cast<float>(mask - 2); }
+
   void write(float sample)
   {
     ++current_pos;
@@ -23,7 +41,7 @@ public:
 
   void clear()
   {
-    std::fill(samples, samples + N, 0.f);
+    std::fill(samples, samples + mask + 1, 0.f);
   }
 
   float read_linear(float delay) const
@@ -64,7 +82,7 @@ private:
     // if delay > current_pos, underflow happens but (& mask) makes it semantically correct
   }
 
-  static constexpr size_t mask = N - 1;
+  size_t mask = N - 1;
   float *samples = nullptr;
   size_t current_pos = 0;
 };
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// L parallel linear ramps, one per voice, interpolating coefficients that are
+// computed once per block. Call begin_block() first, then set_target() for the
+// lanes whose target changed, then process_sample() once per sample.
+template <size_t L>
+class LinearRamp
+{
+public:
+  void reset(float x)
+  {
+    value.fill(x);
+    target.fill(x);
+    step.fill(0.f);
+  }
+
+  // lands every lane exactly on its target, so rounding errors do not accumulate
+  void begin_block()
+  {
+    value = target;
+    step.fill(0.f);
+  }
+
+  // frames == 0 jumps to the target immediately
+  void set_target(size_t lane, float x, uint32_t frames)
+  {
+    target[lane] = x;
+    if (frames == 0)
+    {
+      value[lane] = x;
+      step[lane] = 0.f;
+    }
+    else
+    {
+      step[lane] = (x - value[lane]) / static_cast<float>(frames);
+    }
+  }
+
+  void process_sample()
+  {
+    for (size_t i = 0; i < L; ++i)
+      value[i] += step[i];
+  }
+
+  float operator[](size_t lane) const { return value[lane]; }
+
+private:
+  std::array<float, L> value = {};
+  std::array<float, L> target = {};
+  std::array<float, L> step = {};
+};
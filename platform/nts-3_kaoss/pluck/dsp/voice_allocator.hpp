@@ -1,12 +1,18 @@
 #pragma once
-#include <algorithm>
 #include <array>
-#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
 
 /**
- * @brief round-robin, closest note voice stealing voice allocator
+ * @brief bitmask voice allocator, steals the quietest voice
  * @author Shijie Xia, Korg Inc.
- * @note simplfied version of H. Fujii's assigner
+ *
+ * Voices are free, held (note on) or released (note off, tail still ringing).
+ * Free and held voices are bitmasks and notes map directly to their voice, so
+ * note on/off never search the voice array. A released voice becomes free
+ * once set_level() reports it below SILENCE, fed from the voice's envelope or
+ * energy tracker. When no voice is free, the quietest released voice is
+ * stolen, then the quietest held one.
  */
 
 #define INVALID_VOICE 0xFF
@@ -14,55 +20,102 @@
 template <size_t N>
 class VoiceAllocator {
 public:
-  VoiceAllocator() { voices.fill(-1); }
+  static_assert(N > 0 && N <= 32, "N must be in [1, 32]");
+
+  static constexpr float SILENCE = 1e-4f; // -80 dB
+
+  VoiceAllocator() { reset(); }
+
+  void reset() {
+    free_mask = ALL_VOICES;
+    held_mask = 0;
+    note_to_voice.fill(INVALID_VOICE);
+    voice_to_note.fill(INVALID_NOTE);
+    levels.fill(0.f);
+    next_voice = 0;
+  }
 
   void set_roundrobin(bool enabled) { roundrobin = enabled; }
 
   uint8_t note_on(uint8_t note_number) {
+    note_number &= 0x7F;
     if (!roundrobin)
       next_voice = 0;
 
-    // 1) retrigger if already playing
-    auto it = std::find(voices.begin(), voices.end(), note_number);
-    if (it != voices.end()) {
-      return static_cast<uint8_t>(std::distance(voices.begin(), it));
-    }
+    // 1) retrigger the voice still playing or ringing this note
+    uint8_t slot = note_to_voice[note_number];
 
-    // 2) claim a free voice (round-robin)
-    for (uint8_t k = 0; k < N; ++k) {
-      uint8_t slot = (next_voice + k) % N;
-      if (voices[slot] < 0) {
-        voices[slot] = note_number;
-        next_voice = (slot + 1) % N;
-        return slot;
-      }
+    // 2) claim a free voice, round-robin from next_voice
+    if (slot == INVALID_VOICE && free_mask != 0) {
+      const uint64_t twice = static_cast<uint64_t>(free_mask) | (static_cast<uint64_t>(free_mask) << N);
+      slot = static_cast<uint8_t>((__builtin_ctzll(twice >> next_voice) + next_voice) % N);
     }
 
-    // 3) steal the closest note
-    uint8_t victim = next_voice;
-    for (uint8_t k = 1; k < N; ++k) {
-      uint8_t slot = (next_voice + k) % N;
-      if (std::abs(voices[slot] - note_number) <
-          std::abs(voices[victim] - note_number)) {
-        victim = slot;
-      }
+    // 3) steal the quietest released voice, or the quietest held one
+    if (slot == INVALID_VOICE) {
+      const uint32_t released = ~free_mask & ~held_mask & ALL_VOICES;
+      slot = quietest(released != 0 ? released : held_mask);
+      note_to_voice[voice_to_note[slot]] = INVALID_VOICE;
     }
 
-    voices[victim] = note_number;
-    next_voice = (victim + 1) % N;
-    return victim;
+    free_mask &= ~(1u << slot);
+    held_mask |= 1u << slot;
+    note_to_voice[note_number] = slot;
+    voice_to_note[slot] = note_number;
+    levels[slot] = 1.f; // not a steal candidate until its tracker reports
+    next_voice = static_cast<uint8_t>((slot + 1) % N);
+    return slot;
   }
 
+  // the voice keeps ringing and keeps its note until it is freed or stolen
   uint8_t note_off(uint8_t note_number) {
-    auto it = std::find(voices.begin(), voices.end(), note_number);
-    if (it == voices.end())
-      return INVALID_VOICE;
-    *it = -1;
-    return static_cast<uint8_t>(std::distance(voices.begin(), it));
+    const uint8_t slot = note_to_voice[note_number & 0x7F];
+    if (slot != INVALID_VOICE)
+      held_mask &= ~(1u << slot);
+    return slot;
+  }
+
+  // current amplitude of a voice, frees released voices that have gone silent
+  void set_level(size_t voice, float level) {
+    levels[voice] = level;
+    const uint32_t bit = 1u << voice;
+    if (level < SILENCE && !(held_mask & bit) && !(free_mask & bit))
+      release(static_cast<uint8_t>(voice));
   }
 
+  // frees a voice right away
+  void release(uint8_t voice) {
+    const uint32_t bit = 1u << voice;
+    if (free_mask & bit)
+      return;
+    note_to_voice[voice_to_note[voice]] = INVALID_VOICE;
+    voice_to_note[voice] = INVALID_NOTE;
+    held_mask &= ~bit;
+    free_mask |= bit;
+  }
+
+  // bit i is set while voice i is held or ringing
+  uint32_t active_mask() const { return ~free_mask & ALL_VOICES; }
+
 private:
+  static constexpr uint32_t ALL_VOICES = static_cast<uint32_t>((1ull << N) - 1);
+  enum : uint8_t { INVALID_NOTE = 0x80 };
+
+  uint8_t quietest(uint32_t mask) const {
+    uint8_t victim = static_cast<uint8_t>(__builtin_ctz(mask));
+    for (mask &= mask - 1; mask != 0; mask &= mask - 1) {
+      const uint8_t i = static_cast<uint8_t>(__builtin_ctz(mask));
+      if (levels[i] < levels[victim])
+        victim = i;
+    }
+    return victim;
+  }
+
   bool roundrobin = true;
   uint8_t next_voice = 0;
-  std::array<int8_t, N> voices;
+  uint32_t free_mask = ALL_VOICES;
+  uint32_t held_mask = 0;
+  std::array<uint8_t, 128> note_to_voice;
+  std::array<uint8_t, N> voice_to_note;
+  std::array<float, N> levels;
 };
@@ -39,6 +39,7 @@
  *
  */
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 
@@ -52,7 +53,11 @@
 #include "dsp/one_pole.hpp"
 #include "dsp/dc_blocker.hpp"
 #include "dsp/thiran_allpass.hpp"
+#include "dsp/linear_ramp.hpp"
+#include "dsp/NoiseBlock.h"
+#include "dsp/Oversampler.h"
 #include "dsp/voice_allocator.hpp"
+#include "dsp/SdramArena.h" // platform independent, shared with the microkorg2 units
 
 inline float overdrive(float x, float drive)
 {
@@ -91,105 +96,266 @@ struct Params
   Params() { reset(); }
 };
 
-// ---- Single Karplus-Strong waveguide voice ----------------------------------------
+// ---- Karplus-Strong voice bank ----------------------------------------------------
 
 /**
- * @brief One Karplus-Strong waveguide string.
+ * @brief V Karplus-Strong waveguide strings in structure-of-arrays layout.
  * @author Shijie Xia (xiashj@korg.co.jp)
  *
- * External SDRAM buffer must be assigned via set_memory() before use.
+ * Filter states are stored per stage across voices and every stage runs over
+ * all voices before the next one. Each string keeps its serial feedback loop,
+ * but the inner loops are independent per voice and free of calls and branches.
+ * The loops only visit the voices passed to set_active_mask(), so idle strings
+ * cost nothing but their coefficient ramps.
+ * External SDRAM buffers must be assigned via set_memory() before use.
  */
-class Waveguide
+template <size_t V>
+class WaveguideBank
 {
 public:
-  static constexpr size_t N = 4096;
+  // C1 at 48 kHz needs ~1470 samples plus modulation headroom
+  static constexpr size_t N = 2048;
   static constexpr size_t M_DISPERSION = 8;
 
-  void set_memory(float *mem)
+  void set_memory(size_t voice, float *mem)
   {
-    delay.set_memory(mem);
+    delay[voice].set_memory(mem);
   }
 
-  void init(float samplerate)
+  // seed decorrelates the noise of several instances
+  void init(float samplerate, uint32_t seed)
   {
     sr = samplerate;
-    damp_filter.reset();
-    noise_filter.reset();
-    dc_blocker.reset(sr);
-    dispersion_filter.reset();
-    curved_bridge = 0.f;
+    noise_src.Seed(seed);
+    dc_pole = 1.f - 20.f / std::max(sr, 40.f);
+    for (size_t i = 0; i < V; ++i)
+    {
+      reset_loop(i);
+      peak[i] = 0.f;
+      dc_x1[i] = 0.f;
+      dc_y1[i] = 0.f;
+      pitch[i] = 440.f;
+      coeffs_valid[i] = false;
+    }
+    params_valid = false;
   }
 
-  void pluck(float hz, const Params &p)
+  void pluck(size_t voice, float hz, const Params &p)
   {
-    pitch = hz;
+    pitch[voice] = hz;
 
-    delay.clear();
-    damp_filter.reset();
-    noise_filter.reset();
-    curved_bridge = 0.f;
-    dispersion_filter.reset();
+    // only the region this pitch can reach is addressed and cleared
+    DelayLine<N> &d = delay[voice];
+    d.resize(static_cast<size_t>(compute_string_len_samples(hz) * HEADROOM) + 4);
+    d.clear();
+    reset_loop(voice);
 
+    OnePole noise_filter;
     noise_filter.set_lp(p.noise_cutoff / sr);
 
-    const float string_len = compute_string_len_samples(pitch);
+    const float string_len = compute_string_len_samples(hz);
     for (size_t i = 0; i < static_cast<size_t>(string_len) + 1; ++i)
     {
-      float noise = osc_white();
+      float noise = noise_src.White();
       noise = noise_filter.process_sample(noise);
-      delay.write(noise);
+      d.write(noise);
     }
+
+    // a new note starts on its own coefficients, no glide from the previous one
+    coeffs_valid[voice] = false;
   }
 
-  // Returns output sample before overdrive.
-  float process_sample(const Params &p, float input_mono)
+  void mute()
   {
-    const auto [a1, dc_delay_samples] = compute_allpass(pitch, p.dispersion);
-    dispersion_filter.set_coeff(a1);
+    for (auto &d : delay)
+      d.clear();
+    peak.fill(0.f);
+  }
 
-    const float string_len = compute_string_len_samples(pitch, dc_delay_samples);
+  // peak of the voice output over the last block, feeds the voice allocator
+  float level(size_t voice) const
+  {
+    return peak[voice];
+  }
 
-    damp_filter.set_damp(p.damp);
+  // bit i set renders voice i, call before update_coeffs()
+  void set_active_mask(uint32_t mask)
+  {
+    active_mask = mask;
+    num_active = 0;
+    for (size_t i = 0; i < V; ++i)
+    {
+      if (mask & (1u << i))
+        active[num_active++] = static_cast<uint8_t>(i);
+    }
+  }
 
-    const float rt60_samples = 0.07f * std::pow(2.f, p.decay * 8.f) * sr;
-    const float w = 2.f * M_PI / (string_len + 1.f);
-    const float fir_gain = damp_filter.magnitude_at(w);
-    const float exponent = std::max(-10.f * string_len / rt60_samples, -127.f / 12.f);
-    const float gain = std::min(std::pow(2.f, exponent) / std::max(fir_gain, 0.001f), 1.f);
+  // Call once per block before process_sample().
+  // Loop coefficients are only recomputed for voices whose pitch or related
+  // parameters changed, and are then ramped over the block to avoid zipper noise.
+  void update_coeffs(const Params &p, uint32_t frames)
+  {
+    bridge_amount = p.stiffness * p.stiffness * 0.01f;
+    noise_fm_depth = p.noise_fm_amount * 0.025f;
+    dispersion_on = p.dispersion > 0.f;
+
+    const bool params_changed = !params_valid || p.damp != cached_params.damp || p.decay != cached_params.decay ||
+                                p.pickup_pos != cached_params.pickup_pos || p.dispersion != cached_params.dispersion;
+
+    allpass_ramp.begin_block();
+    string_len_ramp.begin_block();
+    gain_ramp.begin_block();
+    comb_delay_ramp.begin_block();
+    peak.fill(0.f);
+
+    // damping is shared by all voices: [0, 1] -> [0, 0.25]
+    fir_h0 = fir_h0_target;
+    fir_h0_target = clampf(p.damp / 4.f, 0.f, 0.25f);
+    fir_h0_step = (params_valid && frames > 0) ? (fir_h0_target - fir_h0) / static_cast<float>(frames) : 0.f;
+    if (fir_h0_step == 0.f)
+      fir_h0 = fir_h0_target;
+
+    for (size_t i = 0; i < V; ++i)
+    {
+      // idle voices jump to fresh coefficients once they are rendered again
+      if (!(active_mask & (1u << i)))
+        coeffs_valid[i] = false;
+      else if (params_changed || !coeffs_valid[i])
+        compute_coeffs(i, p, coeffs_valid[i] ? frames : 0);
+    }
 
-    noise_filter.set_lp(p.noise_cutoff / sr);
+    cached_params = p;
+    params_valid = true;
+  }
 
-    const float comb_delay_samples = 0.5f * p.pickup_pos * sr / pitch;
-    const float bridge_amount = p.stiffness * p.stiffness * 0.01f;
+  // Returns the sum of all voices before overdrive.
+  float process_sample(float input_mono)
+  {
+    allpass_ramp.process_sample();
+    string_len_ramp.process_sample();
+    gain_ramp.process_sample();
+    comb_delay_ramp.process_sample();
+    fir_h0 += fir_h0_step;
+    const float h0 = fir_h0;
+    const float h1 = 1.f - 2.f * h0;
+
+    std::array<float, V> delay_out;
+    std::array<float, V> v;
+    std::array<float, V> fm_noise;
+    float mix = 0.f;
+
+    for (size_t i = 0; i < V; ++i)
+      fm_noise[i] = noise_src.White();
+
+    // delay reads, one gather per voice
+    for (size_t k = 0; k < num_active; ++k)
+    {
+      const size_t i = active[k];
+      float string_len_modulated = string_len_ramp[i] * (1.f - curved_bridge[i] * bridge_amount);
+      string_len_modulated = string_len_modulated * (1.f + fm_noise[i] * noise_fm_depth);
+      string_len_modulated = std::min(string_len_modulated, delay[i].max_delay());
+      delay_out[i] = delay[i].read_lagrange_2nd(string_len_modulated);
+    }
 
-    float string_len_modulated = string_len * (1.f - curved_bridge * bridge_amount);
-    string_len_modulated = string_len_modulated * (1.f + osc_white() * p.noise_fm_amount * 0.025f);
+    // output path: pickup comb and curved bridge
+    for (size_t k = 0; k < num_active; ++k)
+    {
+      const size_t i = active[k];
+      float y = delay_out[i];
+      if (comb_delay_ramp[i] > 1.f)
+        y -= delay[i].read_linear(comb_delay_ramp[i]);
+      curved_bridge[i] = compute_curved_bridge(y);
+      peak[i] = std::max(peak[i], std::fabs(y));
+      mix += y;
+    }
 
-    const float delay_out = delay.read_lagrange_2nd(string_len_modulated);
+    // === feedback loop ===
+    // dc blocker: H(z) = (1 - z^-1) / (1 - R*z^-1)
+    for (size_t k = 0; k < num_active; ++k)
+    {
+      const size_t i = active[k];
+      const float x = delay_out[i] + input_mono;
+      const float y = x - dc_x1[i] + dc_pole * dc_y1[i];
+      dc_x1[i] = x;
+      dc_y1[i] = y;
+      v[i] = y;
+    }
 
-    float y = delay_out;
-    if (comb_delay_samples > 1.f)
-      y -= delay.read_linear(comb_delay_samples);
+    // damp filter, 3-tap symmetric FIR [h0, h1, h0]
+    for (size_t k = 0; k < num_active; ++k)
+    {
+      const size_t i = active[k];
+      const float x = v[i];
+      v[i] = h1 * fir_z1[i] + h0 * (x + fir_z2[i]);
+      fir_z2[i] = fir_z1[i];
+      fir_z1[i] = x;
+    }
 
-    curved_bridge = compute_curved_bridge(y);
+    // dispersion, cascade of first-order Thiran allpass stages
+    if (dispersion_on)
+    {
+      for (size_t m = 0; m < M_DISPERSION; ++m)
+      {
+        for (size_t k = 0; k < num_active; ++k)
+        {
+          const size_t i = active[k];
+          const float y = allpass_ramp[i] * (v[i] - ap_yp[m][i]) + ap_xp[m][i];
+          ap_xp[m][i] = v[i];
+          ap_yp[m][i] = y;
+          v[i] = y;
+        }
+      }
+    }
 
-    // === feedback loop ===
-    float v = delay_out + input_mono;
-    v = dc_blocker.process_sample(v);
-    v = damp_filter.process_sample(v);
-    if (p.dispersion > 0.f)
-      v = dispersion_filter.process_sample(v);
-    v *= gain;
-    delay.write(v);
-
-    return y;
+    for (size_t k = 0; k < num_active; ++k)
+    {
+      const size_t i = active[k];
+      delay[i].write(v[i] * gain_ramp[i]);
+    }
+
+    return mix;
   }
 
-  void mute() { delay.clear(); }
+private:
+  // noise FM (+2.5%) and the curved bridge can lengthen the loop beyond the nominal length
+  static constexpr float HEADROOM = 1.125f;
 
-  float pitch = 440.f;
+  void reset_loop(size_t i)
+  {
+    fir_z1[i] = 0.f;
+    fir_z2[i] = 0.f;
+    curved_bridge[i] = 0.f;
+    for (size_t m = 0; m < M_DISPERSION; ++m)
+    {
+      ap_xp[m][i] = 0.f;
+      ap_yp[m][i] = 0.f;
+    }
+  }
+
+  void compute_coeffs(size_t i, const Params &p, uint32_t frames)
+  {
+    const auto [a1, dc_delay_samples] = compute_allpass(pitch[i], p.dispersion);
+    const float string_len = compute_string_len_samples(pitch[i], dc_delay_samples);
+
+    SymmetricFir3 fir;
+    fir.set_damp(p.damp);
+
+    const float rt60_samples = 0.07f * std::pow(2.f, p.decay * 8.f) * sr;
+    const float w = 2.f * M_PI / (string_len + 1.f);
+    const float fir_gain = fir.magnitude_at(w);
+    const float exponent = std::max(-10.f * string_len / rt60_samples, -127.f / 12.f);
+    const float gain = std::min(std::pow(2.f, exponent) / std::max(fir_gain, 0.001f), 1.f);
+
+    const float comb_delay_samples = 0.5f * p.pickup_pos * sr / pitch[i];
+
+    allpass_ramp.set_target(i, a1, frames);
+    string_len_ramp.set_target(i, string_len, frames);
+    gain_ramp.set_target(i, gain, frames);
+    comb_delay_ramp.set_target(i, comb_delay_samples, frames);
+
+    coeffs_valid[i] = true;
+  }
 
-private:
   float compute_string_len_samples(float pitch_hz, float extra_delay = 0.f) const
   {
     const float delay_samples = sr / pitch_hz - 1.f - extra_delay;
@@ -225,15 +391,41 @@ private:
   }
 
   float sr = 48000.f;
-  DelayLine<N> delay;
-  SymmetricFir3 damp_filter;
-  OnePole noise_filter;
-  DcBlocker dc_blocker;
-  ThiranAllpassCascade<M_DISPERSION> dispersion_filter;
-  float curved_bridge = 0.f;
+  float dc_pole = 0.999f;
+  std::array<DelayLine<N>, V> delay;
+  std::array<float, V> pitch = {};
+
+  // filter states, one lane per voice
+  std::array<float, V> dc_x1 = {};
+  std::array<float, V> dc_y1 = {};
+  std::array<float, V> fir_z1 = {};
+  std::array<float, V> fir_z2 = {};
+  std::array<std::array<float, V>, M_DISPERSION> ap_xp = {};
+  std::array<std::array<float, V>, M_DISPERSION> ap_yp = {};
+  std::array<float, V> curved_bridge = {};
+  std::array<float, V> peak = {};
+  std::array<uint8_t, V> active = {};
+  size_t num_active = 0;
+  uint32_t active_mask = 0;
+  dsp::NoiseBlock noise_src;
+
+  // block-rate coefficient cache
+  Params cached_params;
+  bool params_valid = false;
+  std::array<bool, V> coeffs_valid = {};
+  bool dispersion_on = false;
+  float bridge_amount = 0.f;
+  float noise_fm_depth = 0.f;
+  float fir_h0 = 0.f;
+  float fir_h0_target = 0.f;
+  float fir_h0_step = 0.f;
+  LinearRamp<V> allpass_ramp;
+  LinearRamp<V> string_len_ramp;
+  LinearRamp<V> gain_ramp;
+  LinearRamp<V> comb_delay_ramp;
 };
 
-// ---- Polyphonic effect (NUM_VOICES waveguides + round-robin allocator) -------------
+// ---- Polyphonic effect (NUM_VOICES waveguides + bitmask allocator) -------------
 
 /**
  * @brief Polyphonic Karplus-Strong for NTS-3 kaoss pad kit.
@@ -241,14 +433,21 @@ private:
  *
  * Touch X maps continuously to pitch (C1–C5, 4 octaves).
  * Touch Y maps to damp (bottom=bright, top=dark) via default_mappings.
- * Each phase_began strikes a new voice in round-robin order.
+ * Each phase_began strikes a free voice in round-robin order, or steals the quietest one.
  */
 class Effect : public Processor
 {
 public:
   static constexpr size_t NUM_VOICES = 4;
+  using Strings = WaveguideBank<NUM_VOICES>;
+  using Allocator = VoiceAllocator<NUM_VOICES>;
+  using DriveOversampler = dsp::Oversampler<2, 1>;
 
-  uint32_t getBufferSize() const override final { return NUM_VOICES * Waveguide::N; }
+  // N floats per voice, plus one cache line of slack so voice lines can be aligned regardless of where the block starts
+  uint32_t getBufferSize() const override final
+  {
+    return NUM_VOICES * Strings::N + dsp::SdramArena::kAlignCacheLine / sizeof(float);
+  }
 
   // audio parameters
   enum
@@ -307,44 +506,85 @@ public:
   void init(float *allocated_buffer) override final
   {
     buffer = allocated_buffer;
+    arena.SetMemory(buffer, getBufferSize() * sizeof(float));
+    memory_ok = true;
     for (size_t i = 0; i < NUM_VOICES; ++i)
     {
-      voices[i].set_memory(buffer + i * Waveguide::N);
-      voices[i].init(getSampleRate());
+      float *line = arena.Allocate<float>(Strings::N, dsp::SdramArena::kAlignCacheLine);
+      memory_ok = memory_ok && line != nullptr;
+      voices.set_memory(i, line);
     }
+    voices.init(getSampleRate(), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)));
+    drive_os.SetPreset(DriveOversampler::kLowLatency);
+    drive_fade = 0.f;
     params.reset();
   }
 
-  void teardown() override final { buffer = nullptr; }
+  void teardown() override final
+  {
+    arena.SetMemory(nullptr, 0);
+    memory_ok = false;
+    buffer = nullptr;
+  }
 
   void process(const float *__restrict in, float *__restrict out, uint32_t frames) override final
   {
+    // without delay lines the strings cannot run, output silence
+    if (!memory_ok)
+    {
+      std::fill(out, out + frames * 2, 0.f);
+      return;
+    }
+
     const Params p = params;
 
+    // rung out strings are skipped, unless there is input for them to resonate with
+    float in_peak = 0.f;
+    for (uint32_t i = 0; i < frames * 2; ++i)
+      in_peak = std::max(in_peak, std::fabs(in[i]));
+    const bool has_input = in_peak * (0.5f / NUM_VOICES) >= Allocator::SILENCE;
+    voices.set_active_mask(has_input ? (1u << NUM_VOICES) - 1 : allocator.active_mask());
+
+    voices.update_coeffs(p, frames);
+
+    // at zero drive the shaper is linear, so the oversampler is skipped and faded back in when drive is raised
+    const float drive_target = (p.drive > 0.f) ? 1.f : 0.f;
+    if (drive_fade == 0.f && drive_target > 0.f)
+      drive_os.Reset();
+
     for (const float *out_end = out + frames * 2; out != out_end; in += 2, out += 2)
     {
       const float input_mono = (in[0] + in[1]) * 0.5f / NUM_VOICES;
 
-      float mix = 0.f;
-      for (auto &v : voices)
-        mix += v.process_sample(p, input_mono);
-      mix /= static_cast<float>(NUM_VOICES);
+      const float mix = voices.process_sample(input_mono) / static_cast<float>(NUM_VOICES);
 
-      // overdrive applied to the mix of all voices
-      const float y = overdrive(mix, p.drive);
+      // overdrive applied to the mix of all voices, at 2x to keep the harmonics from aliasing
+      float y = mix;
+      if (drive_fade > 0.f || drive_target > 0.f)
+      {
+        drive_fade = (drive_target > 0.f) ? std::min(drive_fade + DRIVE_FADE_STEP, 1.f) : std::max(drive_fade - DRIVE_FADE_STEP, 0.f);
+        const float driven = drive_os.ProcessX1(mix, [&p](float x) { return overdrive(x, p.drive); });
+        y = mix + drive_fade * (driven - mix);
+      }
       out[0] = y;
       out[1] = y;
     }
+
+    for (size_t i = 0; i < NUM_VOICES; ++i)
+      allocator.set_level(i, voices.level(i));
   }
 
   inline void touchEvent(uint8_t id, uint8_t phase, uint32_t x, uint32_t y) override final
   {
     (void)id;
 
+    if (!memory_ok)
+      return;
+
     if (phase == k_unit_touch_phase_ended || phase == k_unit_touch_phase_cancelled)
     {
-      for (auto &v : voices)
-        v.mute();
+      voices.mute();
+      allocator.reset();
       last_col = last_row = UINT32_MAX;
       return;
     }
@@ -364,18 +604,25 @@ public:
 
   void pluck_note(uint8_t note)
   {
+    // a plucked string is released at once and its voice is freed when it has rung out
     const size_t slot = allocator.note_on(note);
-    voices[slot].pluck(note_to_hz(note), params);
+    allocator.note_off(note);
+    voices.pluck(slot, note_to_hz(note), params);
   }
 
   static constexpr uint32_t COLS      = 12;
   static constexpr uint32_t ROWS      = 8;
   static constexpr uint8_t  BASE_NOTE = 24; // C1; grid spans C1–Bb4 (MIDI 24–70)
+  static constexpr float    DRIVE_FADE_STEP = 1.f / 64.f; // bypass crossfade, ~1.3 ms @ 48 kHz
 
   float *buffer = nullptr;
+  dsp::SdramArena arena;
+  bool memory_ok = false; // every voice got its delay line
   Params params;
-  std::array<Waveguide, NUM_VOICES> voices;
-  VoiceAllocator<NUM_VOICES> allocator;
+  Strings voices;
+  DriveOversampler drive_os;
+  float drive_fade = 0.f; // 0 bypasses drive_os, 1 is fully driven
+  Allocator allocator;
   uint32_t last_col = UINT32_MAX;
   uint32_t last_row = UINT32_MAX;
 };